@@ -0,0 +1,53 @@
+#ifndef CIRCULAR_CONTAINER_BENCH_COMMON_H_
+#define CIRCULAR_CONTAINER_BENCH_COMMON_H_
+
+#include <mutex>
+#include <thread>
+#include "CircularContainer.hpp"
+
+namespace bench {
+// Baseline for the concurrent rings: a CircularContainer behind a mutex with
+// the same try_push/try_pop interface.
+template<typename Tp, std::size_t _capacity>
+class LockedCircularContainer {
+  public:
+    bool try_push(const Tp& item) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_ring.full()) {
+        return false;
+      }
+      m_ring.push_back(item);
+      return true;
+    }
+
+    bool try_pop(Tp& item) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_ring.empty()) {
+        return false;
+      }
+      item = m_ring.front();
+      m_ring.pop_front();
+      return true;
+    }
+
+  private:
+    std::mutex m_mutex;
+    vfc::CircularContainer<Tp, _capacity> m_ring;
+};
+
+template<typename Queue, typename Tp>
+void push_spin(Queue& queue, const Tp& item) {
+  while (!queue.try_push(item)) {
+    std::this_thread::yield();
+  }
+}
+
+template<typename Queue, typename Tp>
+void pop_spin(Queue& queue, Tp& item) {
+  while (!queue.try_pop(item)) {
+    std::this_thread::yield();
+  }
+}
+}
+
+#endif // CIRCULAR_CONTAINER_BENCH_COMMON_H_
@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "BlockingCircularContainer.hpp"
+#include "CircularContainer.hpp"
+
+// Wake-up latency and CPU cost of BlockingCircularContainer against a
+// CircularContainer guarded by a mutex and two condition variables. All
+// benchmarks measure process CPU time next to real time, so the CPU column
+// shows how much the sleeping side burns while it waits.
+
+namespace {
+constexpr std::size_t kCapacity = 1024;
+constexpr int kBatch = 4096;
+
+// Baseline: the textbook mutex + condition_variable bounded queue.
+template<typename Tp, std::size_t _capacity>
+class CondvarCircularContainer {
+  public:
+    bool push_wait(const Tp& item) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_not_full.wait(lock, [this] { return !m_ring.full(); });
+      m_ring.push_back(item);
+      lock.unlock();
+      m_not_empty.notify_one();
+      return true;
+    }
+
+    bool pop_wait(Tp& item) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_not_empty.wait(lock, [this] { return !m_ring.empty(); });
+      item = m_ring.front();
+      m_ring.pop_front();
+      lock.unlock();
+      m_not_full.notify_one();
+      return true;
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    vfc::CircularContainer<Tp, _capacity> m_ring;
+};
+
+// Round trip through an echo thread: every message finds the other side
+// asleep on an empty ring, so this is two wake-ups per iteration.
+template<typename Queue>
+void run_round_trip(benchmark::State& state) {
+  Queue ping;
+  Queue pong;
+  std::thread echo([&] {
+    int item;
+    while (ping.pop_wait(item) && item >= 0) {
+      pong.push_wait(item);
+    }
+  });
+
+  int value = 0;
+  for (auto _ : state) {
+    ping.push_wait(value);
+    int item;
+    pong.pop_wait(item);
+    benchmark::DoNotOptimize(item);
+    value = (value + 1) & 0x7fffffff;
+  }
+  ping.push_wait(-1);
+  echo.join();
+}
+
+// One producer streams to one consumer; the ring is rarely empty or full, so
+// this is the mostly uncontended path.
+template<typename Queue>
+void run_stream(benchmark::State& state) {
+  Queue queue;
+  const auto total = static_cast<long>(state.max_iterations) * kBatch;
+  std::thread consumer([&] {
+    int item;
+    for (long i = 0; i < total; ++i) {
+      queue.pop_wait(item);
+      benchmark::DoNotOptimize(item);
+    }
+  });
+
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; ++i) {
+      queue.push_wait(i);
+    }
+  }
+  consumer.join();
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// A consumer parked on an empty ring for the whole run: real time passes,
+// CPU time should stay near zero (no polling).
+template<typename Queue>
+void run_idle_wait(benchmark::State& state) {
+  Queue queue;
+  std::thread consumer([&] {
+    int item;
+    queue.pop_wait(item);
+  });
+
+  for (auto _ : state) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  queue.push_wait(0);
+  consumer.join();
+}
+}
+
+using blocking_queue = vfc::BlockingCircularContainer<int, kCapacity>;
+using condvar_queue = CondvarCircularContainer<int, kCapacity>;
+
+static void BM_BlockingRoundTrip(benchmark::State& state) {
+  run_round_trip<vfc::BlockingCircularContainer<int, 16>>(state);
+}
+BENCHMARK(BM_BlockingRoundTrip)->UseRealTime()->MeasureProcessCPUTime();
+
+static void BM_CondvarRoundTrip(benchmark::State& state) {
+  run_round_trip<CondvarCircularContainer<int, 16>>(state);
+}
+BENCHMARK(BM_CondvarRoundTrip)->UseRealTime()->MeasureProcessCPUTime();
+
+static void BM_BlockingStream(benchmark::State& state) {
+  run_stream<blocking_queue>(state);
+}
+BENCHMARK(BM_BlockingStream)->Iterations(2000)->UseRealTime()->MeasureProcessCPUTime();
+
+static void BM_CondvarStream(benchmark::State& state) {
+  run_stream<condvar_queue>(state);
+}
+BENCHMARK(BM_CondvarStream)->Iterations(2000)->UseRealTime()->MeasureProcessCPUTime();
+
+static void BM_BlockingIdleWait(benchmark::State& state) {
+  run_idle_wait<blocking_queue>(state);
+}
+BENCHMARK(BM_BlockingIdleWait)->Iterations(200)->UseRealTime()->MeasureProcessCPUTime();
+
+static void BM_CondvarIdleWait(benchmark::State& state) {
+  run_idle_wait<condvar_queue>(state);
+}
+BENCHMARK(BM_CondvarIdleWait)->Iterations(200)->UseRealTime()->MeasureProcessCPUTime();
+
+// Single-threaded push + pop with nobody waiting: no system call on either side.
+static void BM_BlockingUncontended(benchmark::State& state) {
+  blocking_queue queue;
+  int item = 0;
+  for (auto _ : state) {
+    queue.push_wait(item);
+    queue.pop_wait(item);
+    benchmark::DoNotOptimize(item);
+  }
+}
+BENCHMARK(BM_BlockingUncontended);
+
+static void BM_CondvarUncontended(benchmark::State& state) {
+  condvar_queue queue;
+  int item = 0;
+  for (auto _ : state) {
+    queue.push_wait(item);
+    queue.pop_wait(item);
+    benchmark::DoNotOptimize(item);
+  }
+}
+BENCHMARK(BM_CondvarUncontended);
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <vector>
+#include "CircularContainer.hpp"
+
+// Batch push_back(first, last) / read_into against the same traffic pushed
+// and popped one element at a time, across batch sizes.
+
+namespace {
+constexpr std::size_t kCapacity = 4096;
+}
+
+static void BM_PushBackPerElement(benchmark::State& state) {
+  vfc::CircularContainer<int, kCapacity> c;
+  std::vector<int> batch(static_cast<std::size_t>(state.range(0)));
+  std::iota(batch.begin(), batch.end(), 0);
+  for (auto _ : state) {
+    for (int item : batch) {
+      c.push_back(item);
+    }
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PushBackPerElement)->RangeMultiplier(4)->Range(4, 4096);
+
+static void BM_PushBackBatch(benchmark::State& state) {
+  vfc::CircularContainer<int, kCapacity> c;
+  std::vector<int> batch(static_cast<std::size_t>(state.range(0)));
+  std::iota(batch.begin(), batch.end(), 0);
+  for (auto _ : state) {
+    c.push_back(batch.begin(), batch.end());
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PushBackBatch)->RangeMultiplier(4)->Range(4, 4096);
+
+static void BM_PopPerElement(benchmark::State& state) {
+  vfc::CircularContainer<int, kCapacity> c;
+  const auto n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> batch(n);
+  std::vector<int> out(n);
+  for (auto _ : state) {
+    c.push_back(batch.begin(), batch.end());
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = c.front();
+      c.pop_front();
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PopPerElement)->RangeMultiplier(4)->Range(4, 4096);
+
+static void BM_ReadIntoBatch(benchmark::State& state) {
+  vfc::CircularContainer<int, kCapacity> c;
+  const auto n = static_cast<std::size_t>(state.range(0));
+  std::vector<int> batch(n);
+  std::vector<int> out(n);
+  for (auto _ : state) {
+    c.push_back(batch.begin(), batch.end());
+    c.read_into(out.begin(), n);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadIntoBatch)->RangeMultiplier(4)->Range(4, 4096);
@@ -0,0 +1,280 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "CircularContainer.hpp"
+#if __has_include(<boost/circular_buffer.hpp>)
+#include <boost/circular_buffer.hpp>
+#define CIRCULAR_CONTAINER_BENCH_BOOST 1
+#endif
+
+// Regression suite for the core CircularContainer operations, meant to be
+// compared across releases (run it with --benchmark_out=<file>
+// --benchmark_out_format=json, or build the circular_container_bench_json
+// target). Every operation runs for int, float and a small struct with a
+// std::string, at capacities from 16 to 1M and at several fill levels,
+// against std::deque capped at the same size and, when the headers are
+// available, boost::circular_buffer.
+//
+// Names read <operation>/<container>/<element>/<capacity>/fill:<percent>.
+// Small capacities work on many containers per iteration (together at least
+// 64K slots), so the untimed resets between iterations are amortized.
+//  - push_back: from the fill level, append capacity/2 elements (at 100% all
+//    of them overwrite the oldest).
+//  - pop_front: from the fill level, remove capacity/2 elements.
+//  - iterate: range-for over a container at the fill level.
+//  - insert: insert one element in the middle, then drop the back to stay at
+//    the fill level (the ring drops it itself when full).
+//  - init_list: construct from a braced list of capacity elements.
+
+namespace {
+struct Person {
+  std::string name;
+  int age;
+};
+
+template<typename T>
+T make_value(std::size_t i) {
+  if constexpr (std::is_same_v<T, Person>) {
+    return Person{"person", static_cast<int>(i)};
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
+template<typename T>
+double weight(const T& value) {
+  if constexpr (std::is_same_v<T, Person>) {
+    return value.age;
+  } else {
+    return value;
+  }
+}
+
+// Uniform push/pop/insert over the compared containers. std::deque gets the
+// ring's overwrite-oldest behaviour by hand.
+template<typename T, std::size_t N>
+struct ring {
+  using container = vfc::CircularContainer<T, N>;
+  static constexpr const char* name = "CircularContainer";
+
+  static std::unique_ptr<container> make() {
+    return std::make_unique<container>();
+  }
+  static void push_back(container& c, T value) {
+    c.push_back(std::move(value));
+  }
+  static void insert_middle(container& c, T value) {
+    c.insert(c.begin() + c.size() / 2, std::move(value));
+  }
+};
+
+template<typename T, std::size_t N>
+struct deque {
+  using container = std::deque<T>;
+  static constexpr const char* name = "deque";
+
+  static std::unique_ptr<container> make() {
+    return std::make_unique<container>();
+  }
+  static void push_back(container& c, T value) {
+    if (c.size() == N) {
+      c.pop_front();
+    }
+    c.push_back(std::move(value));
+  }
+  static void insert_middle(container& c, T value) {
+    c.insert(c.begin() + c.size() / 2, std::move(value));
+  }
+};
+
+#ifdef CIRCULAR_CONTAINER_BENCH_BOOST
+template<typename T, std::size_t N>
+struct boost_ring {
+  using container = boost::circular_buffer<T>;
+  static constexpr const char* name = "boost_circular_buffer";
+
+  static std::unique_ptr<container> make() {
+    return std::make_unique<container>(N);
+  }
+  static void push_back(container& c, T value) {
+    c.push_back(std::move(value));
+  }
+  static void insert_middle(container& c, T value) {
+    c.insert(c.begin() + c.size() / 2, std::move(value));
+  }
+};
+#endif
+
+constexpr std::size_t kMinSlots = std::size_t{1} << 16;
+
+template<typename Kind, std::size_t N>
+class fixture {
+  public:
+    using container = typename Kind::container;
+
+    explicit fixture(std::int64_t fill_percent) : m_level(N * fill_percent / 100) {
+      const std::size_t count = N < kMinSlots ? kMinSlots / N : 1;
+      for (std::size_t i = 0; i < count; ++i) {
+        m_containers.push_back(Kind::make());
+      }
+      reset();
+    }
+
+    // Brings every container back to the fill level.
+    void reset() {
+      for (auto& c : m_containers) {
+        c->clear();
+        for (std::size_t i = 0; i < m_level; ++i) {
+          Kind::push_back(*c, make_value<typename container::value_type>(i));
+        }
+      }
+    }
+
+    std::vector<std::unique_ptr<container>>& containers() {
+      return m_containers;
+    }
+
+    [[nodiscard]] std::size_t level() const {
+      return m_level;
+    }
+
+  private:
+    std::size_t m_level;
+    std::vector<std::unique_ptr<container>> m_containers;
+};
+
+template<typename Kind, typename T, std::size_t N>
+void push_back(benchmark::State& state) {
+  fixture<Kind, N> f(state.range(0));
+  for (auto _ : state) {
+    for (auto& c : f.containers()) {
+      for (std::size_t i = 0; i < N / 2; ++i) {
+        Kind::push_back(*c, make_value<T>(i));
+      }
+    }
+    state.PauseTiming();
+    f.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * f.containers().size() * (N / 2));
+}
+
+template<typename Kind, typename T, std::size_t N>
+void pop_front(benchmark::State& state) {
+  fixture<Kind, N> f(state.range(0));
+  for (auto _ : state) {
+    for (auto& c : f.containers()) {
+      for (std::size_t i = 0; i < N / 2; ++i) {
+        c->pop_front();
+      }
+    }
+    state.PauseTiming();
+    f.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * f.containers().size() * (N / 2));
+}
+
+template<typename Kind, typename T, std::size_t N>
+void iterate(benchmark::State& state) {
+  fixture<Kind, N> f(state.range(0));
+  for (auto _ : state) {
+    double sum = 0;
+    for (auto& c : f.containers()) {
+      for (const auto& value : *c) {
+        sum += weight(value);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * f.containers().size() * f.level());
+}
+
+template<typename Kind, typename T, std::size_t N>
+void insert(benchmark::State& state) {
+  fixture<Kind, N> f(state.range(0));
+  const std::size_t level = f.level();
+  for (auto _ : state) {
+    for (auto& c : f.containers()) {
+      Kind::insert_middle(*c, make_value<T>(level));
+      if (c->size() > level) {
+        c->pop_back();
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * f.containers().size());
+}
+
+template<typename T, std::size_t N, std::size_t... I>
+void init_list_ring(benchmark::State& state, std::index_sequence<I...>) {
+  for (auto _ : state) {
+    vfc::CircularContainer<T, N> c{make_value<T>(I)...};
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<typename T, std::size_t N, std::size_t... I>
+void init_list_deque(benchmark::State& state, std::index_sequence<I...>) {
+  for (auto _ : state) {
+    std::deque<T> c{make_value<T>(I)...};
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+std::string label(const char* op, const char* container, const char* type, std::size_t capacity) {
+  return std::string(op) + "/" + container + "/" + type + "/" + std::to_string(capacity);
+}
+
+template<template<typename, std::size_t> class Kind, typename T, std::size_t N>
+void register_container(const char* type) {
+  using kind = Kind<T, N>;
+  benchmark::RegisterBenchmark(label("push_back", kind::name, type, N).c_str(), push_back<kind, T, N>)
+    ->ArgName("fill")->Arg(0)->Arg(50)->Arg(100);
+  benchmark::RegisterBenchmark(label("pop_front", kind::name, type, N).c_str(), pop_front<kind, T, N>)
+    ->ArgName("fill")->Arg(50)->Arg(100);
+  benchmark::RegisterBenchmark(label("iterate", kind::name, type, N).c_str(), iterate<kind, T, N>)
+    ->ArgName("fill")->Arg(50)->Arg(100);
+  benchmark::RegisterBenchmark(label("insert", kind::name, type, N).c_str(), insert<kind, T, N>)
+    ->ArgName("fill")->Arg(50)->Arg(100);
+}
+
+template<typename T, std::size_t N>
+void register_capacity(const char* type) {
+  register_container<ring, T, N>(type);
+  register_container<deque, T, N>(type);
+#ifdef CIRCULAR_CONTAINER_BENCH_BOOST
+  register_container<boost_ring, T, N>(type);
+#endif
+}
+
+template<typename T>
+void register_type(const char* type) {
+  register_capacity<T, 16>(type);
+  register_capacity<T, 1024>(type);
+  register_capacity<T, 65536>(type);
+  register_capacity<T, 1048576>(type);
+  // Braced lists are compile-time sized, so only small ones are measured.
+  benchmark::RegisterBenchmark(label("init_list", "CircularContainer", type, 16).c_str(),
+                               [](benchmark::State& state) { init_list_ring<T, 16>(state, std::make_index_sequence<16>{}); });
+  benchmark::RegisterBenchmark(label("init_list", "deque", type, 16).c_str(),
+                               [](benchmark::State& state) { init_list_deque<T, 16>(state, std::make_index_sequence<16>{}); });
+  benchmark::RegisterBenchmark(label("init_list", "CircularContainer", type, 256).c_str(),
+                               [](benchmark::State& state) { init_list_ring<T, 256>(state, std::make_index_sequence<256>{}); });
+  benchmark::RegisterBenchmark(label("init_list", "deque", type, 256).c_str(),
+                               [](benchmark::State& state) { init_list_deque<T, 256>(state, std::make_index_sequence<256>{}); });
+}
+
+const bool registered = [] {
+  register_type<int>("int");
+  register_type<float>("float");
+  register_type<Person>("Person");
+  return true;
+}();
+}
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CircularContainer.hpp"
+
+// Per-connection histories: a large array of small rings updated in random
+// order, so every update is a likely cache miss. CircularContainer stores its
+// size/head/tail in the smallest type that holds the capacity (19 bytes for 16
+// uint8_t slots); WideRing keeps the former size_t size/head/tail bookkeeping
+// (40 bytes) for comparison.
+
+namespace {
+template<typename Tp, std::size_t N>
+class WideRing {
+  public:
+    void push_back(Tp item) {
+      m_slots[m_tail] = item;
+      m_tail = (m_tail + 1) % N;
+      if (m_size == N) {
+        m_head = (m_head + 1) % N;
+      } else {
+        ++m_size;
+      }
+    }
+
+    template<typename F>
+    void for_each(F f) const {
+      for (std::size_t i = 0, index = m_head; i < m_size; ++i, index = (index + 1) % N) {
+        f(m_slots[index]);
+      }
+    }
+
+  private:
+    Tp m_slots[N];
+    std::size_t m_size = 0;
+    std::size_t m_head = 0;
+    std::size_t m_tail = 0;
+};
+
+const std::vector<std::uint32_t>& visit_order(std::size_t rings) {
+  static std::vector<std::uint32_t> order;
+  order.resize(1 << 20);
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<std::uint32_t> pick(0, static_cast<std::uint32_t>(rings - 1));
+  for (auto& index : order) {
+    index = pick(rng);
+  }
+  return order;
+}
+
+template<typename Ring>
+void touch(Ring& ring, std::uint8_t value, unsigned& sum) {
+  ring.push_back(value);
+  for (auto item : ring) {
+    sum += item;
+  }
+}
+
+template<typename Tp, std::size_t N>
+void touch(WideRing<Tp, N>& ring, std::uint8_t value, unsigned& sum) {
+  ring.push_back(value);
+  ring.for_each([&sum](Tp item) { sum += item; });
+}
+}
+
+// Appends to a random ring and re-reads its history.
+template<typename Ring>
+static void BM_RandomRingUpdate(benchmark::State& state) {
+  const auto rings = static_cast<std::size_t>(state.range(0));
+  std::vector<Ring> histories(rings);
+  const auto& order = visit_order(rings);
+  std::size_t i = 0;
+  unsigned sum = 0;
+  for (auto _ : state) {
+    const std::uint32_t index = order[i++ & (order.size() - 1)];
+    touch(histories[index], static_cast<std::uint8_t>(i), sum);
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bytes_per_ring"] = static_cast<double>(sizeof(Ring));
+}
+
+// Only appends, so the time is dominated by fetching the ring.
+template<typename Ring>
+static void BM_RandomRingPush(benchmark::State& state) {
+  const auto rings = static_cast<std::size_t>(state.range(0));
+  std::vector<Ring> histories(rings);
+  const auto& order = visit_order(rings);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    histories[order[i & (order.size() - 1)]].push_back(static_cast<std::uint8_t>(i));
+    ++i;
+  }
+  benchmark::DoNotOptimize(histories.data());
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bytes_per_ring"] = static_cast<double>(sizeof(Ring));
+}
+
+BENCHMARK_TEMPLATE(BM_RandomRingPush, vfc::CircularContainer<std::uint8_t, 16>)->Arg(1 << 14)->Arg(1 << 20)->Arg(1 << 23);
+BENCHMARK_TEMPLATE(BM_RandomRingPush, WideRing<std::uint8_t, 16>)->Arg(1 << 14)->Arg(1 << 20)->Arg(1 << 23);
+BENCHMARK_TEMPLATE(BM_RandomRingUpdate, vfc::CircularContainer<std::uint8_t, 16>)->Arg(1 << 14)->Arg(1 << 20)->Arg(1 << 23);
+BENCHMARK_TEMPLATE(BM_RandomRingUpdate, WideRing<std::uint8_t, 16>)->Arg(1 << 14)->Arg(1 << 20)->Arg(1 << 23);
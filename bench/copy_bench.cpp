@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <string>
+#include "CircularContainer.hpp"
+
+// Copy and move cost of a large ring against its fill ratio. Only the live
+// elements are transferred (one bulk copy per contiguous run), so copying a
+// mostly empty ring should cost a fraction of copying a std::array of the
+// whole capacity, which is what the container used to do. The rings are
+// filled so that their contents wrap around the end of the buffer.
+
+namespace {
+constexpr std::size_t kCapacity = 1 << 16;
+
+template<typename T>
+T make_value(std::size_t i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::to_string(i);
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
+template<typename T>
+std::unique_ptr<vfc::CircularContainer<T, kCapacity>> make_ring(std::int64_t fill_percent) {
+  auto c = std::make_unique<vfc::CircularContainer<T, kCapacity>>();
+  const std::size_t count = kCapacity * static_cast<std::size_t>(fill_percent) / 100;
+  for (std::size_t i = 0; i < kCapacity / 2 + count; ++i) {
+    c->push_back(make_value<T>(i));
+  }
+  c->pop_front(c->size() - count);
+  return c;
+}
+}
+
+template<typename T>
+static void BM_CopyConstruct(benchmark::State& state) {
+  const auto source = make_ring<T>(state.range(0));
+  for (auto _ : state) {
+    auto copy = std::make_unique<vfc::CircularContainer<T, kCapacity>>(*source);
+    benchmark::DoNotOptimize(copy->size());
+  }
+  state.SetBytesProcessed(state.iterations() * source->size() * sizeof(T));
+}
+
+template<typename T>
+static void BM_MoveConstruct(benchmark::State& state) {
+  const auto source = make_ring<T>(state.range(0));
+  for (auto _ : state) {
+    // Moving from a copy would time the copy as well; the source of a move
+    // keeps its (moved-from) elements, so it can be moved from repeatedly.
+    auto moved = std::make_unique<vfc::CircularContainer<T, kCapacity>>(std::move(*source));
+    benchmark::DoNotOptimize(moved->size());
+  }
+  state.SetBytesProcessed(state.iterations() * source->size() * sizeof(T));
+}
+
+static void BM_CopyWholeArray(benchmark::State& state) {
+  const auto source = std::make_unique<std::array<int, kCapacity + 1>>();
+  for (auto _ : state) {
+    auto copy = std::make_unique<std::array<int, kCapacity + 1>>(*source);
+    benchmark::DoNotOptimize(copy->data());
+  }
+  state.SetBytesProcessed(state.iterations() * sizeof(*source));
+}
+
+static void BM_Swap(benchmark::State& state) {
+  auto a = make_ring<int>(state.range(0));
+  auto b = make_ring<int>(state.range(0) / 2);
+  for (auto _ : state) {
+    a->swap(*b);
+    benchmark::DoNotOptimize(a->size());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_CopyConstruct, int)->ArgName("fill")->Arg(0)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+BENCHMARK_TEMPLATE(BM_MoveConstruct, int)->ArgName("fill")->Arg(0)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, std::string)->ArgName("fill")->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_CopyWholeArray);
+BENCHMARK(BM_Swap)->ArgName("fill")->Arg(10)->Arg(100);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "CircularContainer.hpp"
+
+// CircularContainer as a bounded deque against std::deque capped at the same
+// size. Each iteration applies one operation from a precomputed random mix:
+//  - undo: push_back/pop_back (an undo history; when full the oldest entry goes)
+//  - mixed: push_front/push_back/pop_front/pop_back in equal proportions
+//  - window: push_front only, so a full container drops its back every time
+// std::deque allocates and frees blocks as it grows and shrinks at either end;
+// the ring never allocates.
+
+namespace {
+constexpr std::size_t kCapacity = 1024;
+
+enum op : std::uint8_t { push_front, push_back, pop_front, pop_back };
+
+enum workload { undo, mixed, window };
+
+std::vector<op> make_ops(std::int64_t kind) {
+  std::vector<op> ops(1 << 16);
+  std::uint32_t seed = 12345;
+  for (auto& o : ops) {
+    seed = seed * 1664525u + 1013904223u;
+    const unsigned r = seed >> 24;
+    switch (kind) {
+    case undo: o = r % 5 < 3 ? push_back : pop_back; break; // grows slowly, then wraps
+    case mixed: o = static_cast<op>(r % 4); break;
+    default: o = push_front; break;
+    }
+  }
+  return ops;
+}
+}
+
+static void BM_Ring(benchmark::State& state) {
+  const auto ops = make_ops(state.range(0));
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  std::size_t i = 0;
+  int value = 0;
+  for (auto _ : state) {
+    switch (ops[i++ & (ops.size() - 1)]) {
+    case push_front: c->push_front(value++); break;
+    case push_back: c->push_back(value++); break;
+    case pop_front: c->pop_front(); break;
+    case pop_back: c->pop_back(); break;
+    }
+    benchmark::DoNotOptimize(c->size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Deque(benchmark::State& state) {
+  const auto ops = make_ops(state.range(0));
+  std::deque<int> d;
+  std::size_t i = 0;
+  int value = 0;
+  for (auto _ : state) {
+    switch (ops[i++ & (ops.size() - 1)]) {
+    case push_front:
+      if (d.size() == kCapacity) {
+        d.pop_back();
+      }
+      d.push_front(value++);
+      break;
+    case push_back:
+      if (d.size() == kCapacity) {
+        d.pop_front();
+      }
+      d.push_back(value++);
+      break;
+    case pop_front:
+      if (!d.empty()) {
+        d.pop_front();
+      }
+      break;
+    case pop_back:
+      if (!d.empty()) {
+        d.pop_back();
+      }
+      break;
+    }
+    benchmark::DoNotOptimize(d.size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Ring)->ArgName("workload")->Arg(undo)->Arg(mixed)->Arg(window);
+BENCHMARK(BM_Deque)->ArgName("workload")->Arg(undo)->Arg(mixed)->Arg(window);
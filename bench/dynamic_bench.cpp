@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <memory_resource>
+#include "CircularContainer.hpp"
+#include "DynamicCircularContainer.hpp"
+
+// DynamicCircularContainer against CircularContainer of the same capacity:
+// push_back on a full ring and a full iteration pass. The dynamic ring always
+// wraps by comparison, so it is compared with a fixed capacity that does too
+// (1000) as well as with a power-of-two one (1024). The last case resizes a
+// full ring, which relinearizes it into a new buffer.
+
+namespace {
+constexpr std::size_t kCapacity = 1000;
+constexpr std::size_t kPowerOfTwo = 1024;
+}
+
+template<std::size_t N>
+static void BM_FixedPushBack(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, N>>();
+  int value = 0;
+  for (auto _ : state) {
+    c->push_back(value++);
+    benchmark::DoNotOptimize(c->back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_DynamicPushBack(benchmark::State& state) {
+  vfc::DynamicCircularContainer<int> c(static_cast<std::size_t>(state.range(0)));
+  int value = 0;
+  for (auto _ : state) {
+    c.push_back(value++);
+    benchmark::DoNotOptimize(c.back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_PmrPushBack(benchmark::State& state) {
+  std::pmr::monotonic_buffer_resource arena;
+  vfc::DynamicCircularContainer<int, std::pmr::polymorphic_allocator<int>> c(
+    static_cast<std::size_t>(state.range(0)), &arena);
+  int value = 0;
+  for (auto _ : state) {
+    c.push_back(value++);
+    benchmark::DoNotOptimize(c.back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Container>
+static void fill_and_wrap(Container& c) {
+  for (std::size_t i = 0; i < c.capacity() + c.capacity() / 2; ++i) {
+    c.push_back(static_cast<int>(i));
+  }
+}
+
+template<std::size_t N>
+static void BM_FixedIterate(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, N>>();
+  fill_and_wrap(*c);
+  for (auto _ : state) {
+    long sum = 0;
+    for (int value : *c) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long>(c->size()));
+}
+
+static void BM_DynamicIterate(benchmark::State& state) {
+  vfc::DynamicCircularContainer<int> c(static_cast<std::size_t>(state.range(0)));
+  fill_and_wrap(c);
+  for (auto _ : state) {
+    long sum = 0;
+    for (int value : c) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long>(c.size()));
+}
+
+static void BM_DynamicResize(benchmark::State& state) {
+  const auto capacity = static_cast<std::size_t>(state.range(0));
+  vfc::DynamicCircularContainer<int> c(capacity);
+  bool grow = true;
+  for (auto _ : state) {
+    state.PauseTiming();
+    fill_and_wrap(c);
+    state.ResumeTiming();
+    c.resize_capacity(grow ? capacity * 2 : capacity);
+    grow = !grow;
+    benchmark::DoNotOptimize(c.front());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<long>(capacity));
+}
+
+BENCHMARK_TEMPLATE(BM_FixedPushBack, kCapacity);
+BENCHMARK_TEMPLATE(BM_FixedPushBack, kPowerOfTwo);
+BENCHMARK(BM_DynamicPushBack)->Arg(kCapacity)->Arg(kPowerOfTwo);
+BENCHMARK(BM_PmrPushBack)->Arg(kCapacity);
+BENCHMARK_TEMPLATE(BM_FixedIterate, kCapacity);
+BENCHMARK_TEMPLATE(BM_FixedIterate, kPowerOfTwo);
+BENCHMARK(BM_DynamicIterate)->Arg(kCapacity)->Arg(kPowerOfTwo);
+BENCHMARK(BM_DynamicResize)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "CircularContainer.hpp"
+
+// emplace_back constructing a heavy element directly in its slot, against
+// push_back of a temporary (construct, then move into the slot).
+
+namespace {
+// Same shape as the Person struct used by test.cpp, with a constructor so it
+// can be emplaced from its fields. Names are long enough to live on the heap.
+struct Person {
+  Person(const char* name_, int age_) : name(name_), age(age_) {}
+
+  std::string name;
+  int age;
+};
+
+constexpr const char* kName = "Bartholomew Maximilian Fitzgerald-Montgomery III";
+}
+
+template<std::size_t N>
+static void BM_PushBackTemporary(benchmark::State& state) {
+  vfc::CircularContainer<Person, N> c;
+  int age = 0;
+  for (auto _ : state) {
+    c.push_back(Person(kName, age++));
+    benchmark::DoNotOptimize(c.back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<std::size_t N>
+static void BM_EmplaceBack(benchmark::State& state) {
+  vfc::CircularContainer<Person, N> c;
+  int age = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(c.emplace_back(kName, age++));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// 1000 keeps a spare slot, 1024 overwrites the oldest element in place.
+BENCHMARK_TEMPLATE(BM_PushBackTemporary, 1000);
+BENCHMARK_TEMPLATE(BM_PushBackTemporary, 1024);
+BENCHMARK_TEMPLATE(BM_EmplaceBack, 1000);
+BENCHMARK_TEMPLATE(BM_EmplaceBack, 1024);
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "CircularContainer.hpp"
+
+// Per-thread rings kept side by side in one vector: each thread only touches
+// its own ring, but with the compact layout several small rings (and their
+// head/tail) share a cache line, so the threads invalidate each other's lines
+// on every push. cache_aligned_layout gives every ring whole lines of its own.
+// Run on a machine with at least as many cores as threads; on fewer cores the
+// threads take turns and there is nothing to share.
+
+namespace {
+constexpr std::size_t kCapacity = 4;
+constexpr int kBatch = 4096;
+constexpr int kMaxThreads = 16;
+
+using CompactRing = vfc::CircularContainer<int, kCapacity>;
+using AlignedRing = vfc::CircularContainer<int, kCapacity, vfc::overwrite_oldest, vfc::cache_aligned_layout>;
+
+std::vector<CompactRing> compact_rings(kMaxThreads);
+std::vector<AlignedRing> aligned_rings(kMaxThreads);
+
+template<typename Ring>
+void run_neighbours(benchmark::State& state, std::vector<Ring>& rings) {
+  Ring& ring = rings[static_cast<std::size_t>(state.thread_index())];
+  int value = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; ++i) {
+      ring.push_back(value++);
+      if (i % 2) {
+        ring.pop_front();
+      }
+    }
+    benchmark::DoNotOptimize(ring.front());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+  state.counters["bytes_per_ring"] = benchmark::Counter(sizeof(Ring), benchmark::Counter::kAvgThreads);
+}
+}
+
+static void BM_CompactNeighbours(benchmark::State& state) {
+  run_neighbours(state, compact_rings);
+}
+BENCHMARK(BM_CompactNeighbours)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_AlignedNeighbours(benchmark::State& state) {
+  run_neighbours(state, aligned_rings);
+}
+BENCHMARK(BM_AlignedNeighbours)->ThreadRange(1, kMaxThreads)->UseRealTime();
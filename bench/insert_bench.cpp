@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "CircularContainer.hpp"
+
+// Cost of insert(pos) followed by erase(pos) as a function of where pos lies
+// in a 10k-element ring (percent of size()). Only the shorter side of pos is
+// shifted, so the cost peaks in the middle and is O(1) at both ends; std::deque
+// does the same and is the reference.
+
+namespace {
+constexpr std::size_t kCapacity = 16384;
+constexpr std::size_t kSize = 10000;
+}
+
+template<typename T>
+static T make_value(std::size_t i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(32, static_cast<char>('a' + i % 26));
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
+template<typename T>
+static void BM_RingInsertErase(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<T, kCapacity>>();
+  for (std::size_t i = 0; i < kSize + kSize / 3; ++i) {
+    c->push_back(make_value<T>(i)); // wraps, so the elements span the buffer end
+  }
+  c->pop_front(kSize / 3);
+  const auto at = static_cast<std::ptrdiff_t>(kSize * static_cast<std::size_t>(state.range(0)) / 100);
+  const T value = make_value<T>(42);
+  for (auto _ : state) {
+    auto it = c->insert(c->begin() + at, value);
+    benchmark::DoNotOptimize(*it);
+    c->erase(it);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void BM_DequeInsertErase(benchmark::State& state) {
+  std::deque<T> d;
+  for (std::size_t i = 0; i < kSize; ++i) {
+    d.push_back(make_value<T>(i));
+  }
+  const auto at = static_cast<std::ptrdiff_t>(kSize * static_cast<std::size_t>(state.range(0)) / 100);
+  const T value = make_value<T>(42);
+  for (auto _ : state) {
+    auto it = d.insert(d.begin() + at, value);
+    benchmark::DoNotOptimize(*it);
+    d.erase(it);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+static void BM_RingRangeInsert(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<T, kCapacity>>();
+  for (std::size_t i = 0; i < kSize; ++i) {
+    c->push_back(make_value<T>(i));
+  }
+  const auto at = static_cast<std::ptrdiff_t>(kSize * static_cast<std::size_t>(state.range(0)) / 100);
+  std::vector<T> batch(64, make_value<T>(7));
+  for (auto _ : state) {
+    auto it = c->insert(c->begin() + at, batch.begin(), batch.end());
+    c->erase(it, it + static_cast<std::ptrdiff_t>(batch.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.size()));
+}
+
+static void positions(benchmark::internal::Benchmark* b) {
+  for (int percent : {0, 1, 10, 50, 90, 99, 100}) {
+    b->Arg(percent);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_RingInsertErase, int)->Apply(positions);
+BENCHMARK_TEMPLATE(BM_DequeInsertErase, int)->Apply(positions);
+BENCHMARK_TEMPLATE(BM_RingInsertErase, std::string)->Apply(positions);
+BENCHMARK_TEMPLATE(BM_DequeInsertErase, std::string)->Apply(positions);
+BENCHMARK_TEMPLATE(BM_RingRangeInsert, int)->Apply(positions);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include "CircularContainer.hpp"
+
+// Full-container iteration through the iterators against a plain std::array
+// of the same size. With trivially copyable two-word iterators the loops
+// below should stay in registers, and the power-of-two layout should be
+// within a small factor of the array.
+
+template<std::size_t N>
+using Ring = vfc::CircularContainer<int, N>;
+
+static_assert(std::is_trivially_copyable_v<Ring<4096>::iterator>);
+static_assert(sizeof(Ring<4096>::iterator) == 2 * sizeof(void*));
+
+template<std::size_t N>
+static void BM_RangeForRing(benchmark::State& state) {
+  auto c = std::make_unique<Ring<N>>();
+  for (std::size_t i = 0; i < N + N / 3; ++i) {
+    c->push_back(static_cast<int>(i));
+  }
+  for (auto _ : state) {
+    int sum = 0;
+    for (int v : *c) {
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<std::size_t N>
+static void BM_AccumulateRing(benchmark::State& state) {
+  auto c = std::make_unique<Ring<N>>();
+  for (std::size_t i = 0; i < N + N / 3; ++i) {
+    c->push_back(static_cast<int>(i));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::accumulate(c->begin(), c->end(), 0));
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<std::size_t N>
+static void BM_AccumulateArray(benchmark::State& state) {
+  auto a = std::make_unique<std::array<int, N>>();
+  std::iota(a->begin(), a->end(), 0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::accumulate(a->begin(), a->end(), 0));
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK_TEMPLATE(BM_RangeForRing, 4095);
+BENCHMARK_TEMPLATE(BM_RangeForRing, 4096);
+BENCHMARK_TEMPLATE(BM_AccumulateRing, 4095);
+BENCHMARK_TEMPLATE(BM_AccumulateRing, 4096);
+BENCHMARK_TEMPLATE(BM_AccumulateArray, 4096);
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "CircularContainer.hpp"
+#include "MirroredCircularContainer.hpp"
+
+// Parsing a stream of variable-length records ([uint16 length][payload]) that
+// arrives in fixed-size chunks. With CircularContainer the parser must detect
+// records split across the end of the buffer and copy them out; with the
+// mirrored ring every record is read in place. The smaller the ring relative
+// to the records, the more of them are split.
+
+namespace {
+constexpr std::size_t kChunk = 1500;
+
+// About 4 MiB of records with payloads of 8..512 bytes.
+const std::vector<char>& stream() {
+  static const std::vector<char> bytes = [] {
+    std::vector<char> out;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::uint16_t> length(8, 512);
+    while (out.size() < (4u << 20)) {
+      const std::uint16_t n = length(rng);
+      const auto* header = reinterpret_cast<const char*>(&n);
+      out.insert(out.end(), header, header + sizeof(n));
+      for (std::uint16_t i = 0; i < n; ++i) {
+        out.push_back(static_cast<char>(rng()));
+      }
+    }
+    return out;
+  }();
+  return bytes;
+}
+
+// Stand-in for real record handling: a cheap pass over every payload byte,
+// so that the cost of getting at the record dominates.
+std::uint64_t consume(const char* payload, std::uint16_t length) {
+  std::uint64_t sum = length;
+  for (std::uint16_t i = 0; i < length; ++i) {
+    sum += static_cast<unsigned char>(payload[i]);
+  }
+  return sum;
+}
+}
+
+template<std::size_t RingBytes>
+static void BM_ParseWrapped(benchmark::State& state) {
+  const auto& bytes = stream();
+  auto ring = std::make_unique<vfc::CircularContainer<char, RingBytes>>();
+  std::vector<char> scratch(1 << 16);
+  std::uint64_t records = 0;
+  for (auto _ : state) {
+    std::uint64_t hash = 0;
+    for (std::size_t offset = 0; offset < bytes.size(); offset += kChunk) {
+      const auto end = bytes.begin() + static_cast<std::ptrdiff_t>(std::min(bytes.size(), offset + kChunk));
+      ring->push_back(bytes.begin() + static_cast<std::ptrdiff_t>(offset), end);
+      for (;;) {
+        if (ring->size() < sizeof(std::uint16_t)) {
+          break;
+        }
+        std::uint16_t length;
+        char header[sizeof(length)] = {(*ring)[0], (*ring)[1]}; // the header itself may be split
+        std::memcpy(&length, header, sizeof(length));
+        if (ring->size() < sizeof(length) + length) {
+          break;
+        }
+        ring->pop_front(sizeof(length));
+        const auto run = ring->array_one();
+        if (run.second >= length) {
+          hash += consume(run.first, length);
+          ring->pop_front(length);
+        } else {
+          ring->read_into(scratch.data(), length); // split record: copy it out
+          hash += consume(scratch.data(), length);
+        }
+        ++records;
+      }
+    }
+    ring->clear();
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+  state.counters["records"] = benchmark::Counter(static_cast<double>(records), benchmark::Counter::kIsRate);
+}
+
+static void BM_ParseMirrored(benchmark::State& state) {
+  const auto& bytes = stream();
+  vfc::MirroredCircularContainer<char> ring(static_cast<std::size_t>(state.range(0)));
+  std::uint64_t records = 0;
+  for (auto _ : state) {
+    std::uint64_t hash = 0;
+    for (std::size_t offset = 0; offset < bytes.size(); offset += kChunk) {
+      const std::size_t count = std::min(kChunk, bytes.size() - offset);
+      auto window = ring.contiguous_write(count);
+      std::memcpy(window.first, bytes.data() + offset, window.second);
+      ring.commit_write(window.second);
+      for (;;) {
+        const auto readable = ring.contiguous_read(ring.size());
+        std::uint16_t length;
+        if (readable.second < sizeof(length)) {
+          break;
+        }
+        std::memcpy(&length, readable.first, sizeof(length));
+        if (readable.second < sizeof(length) + length) {
+          break;
+        }
+        hash += consume(readable.first + sizeof(length), length);
+        ring.pop_front(sizeof(length) + length);
+        ++records;
+      }
+    }
+    ring.clear();
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+  state.counters["records"] = benchmark::Counter(static_cast<double>(records), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(BM_ParseWrapped, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ParseWrapped, 65536)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseMirrored)->Arg(4096)->Arg(65536)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include "MpmcCircularContainer.hpp"
+#include "bench_common.hpp"
+
+// Contention scaling of MpmcCircularContainer from 1 to 8 threads on each
+// side, against a CircularContainer guarded by a mutex. Even thread indices
+// produce and odd ones consume, so every run has as many producers as
+// consumers.
+
+namespace {
+constexpr std::size_t kCapacity = 1024;
+constexpr int kBatch = 1024;
+
+vfc::MpmcCircularContainer<int, kCapacity> mpmc_queue;
+bench::LockedCircularContainer<int, kCapacity> locked_queue;
+
+template<typename Queue>
+void run_contention(benchmark::State& state, Queue& queue) {
+  const bool producer = state.thread_index() % 2 == 0;
+  for (auto _ : state) {
+    if (producer) {
+      for (int i = 0; i < kBatch; ++i) {
+        bench::push_spin(queue, i);
+      }
+    } else {
+      int item;
+      for (int i = 0; i < kBatch; ++i) {
+        bench::pop_spin(queue, item);
+        benchmark::DoNotOptimize(item);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+}
+
+static void BM_MpmcContention(benchmark::State& state) {
+  run_contention(state, mpmc_queue);
+}
+BENCHMARK(BM_MpmcContention)->ThreadRange(2, 16)->UseRealTime();
+
+static void BM_MutexContention(benchmark::State& state) {
+  run_contention(state, locked_queue);
+}
+BENCHMARK(BM_MutexContention)->ThreadRange(2, 16)->UseRealTime();
+
+// Single-threaded cost of the overwrite-oldest path on a permanently full ring.
+static void BM_MpmcPushBackOverwrite(benchmark::State& state) {
+  vfc::MpmcCircularContainer<int, kCapacity> queue;
+  int value = 0;
+  for (auto _ : state) {
+    queue.push_back(value++);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MpmcPushBackOverwrite);
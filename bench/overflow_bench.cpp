@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include "CircularContainer.hpp"
+
+// Cost of push_back under each overflow policy on a ring that is kept full,
+// so every push overflows. The default policy is selected with if constexpr
+// and generates the same instructions as before the policies existed (only
+// the symbol names change). reject_when_full is compared with what command
+// queues did before: check full() and then push_back.
+
+namespace {
+constexpr std::size_t kCapacity = 1024;
+constexpr std::size_t kOddCapacity = 1000;
+
+struct counting_sink {
+  std::uint64_t* evicted;
+  void operator()(int&& value) const { *evicted += static_cast<std::uint64_t>(value); }
+};
+}
+
+template<std::size_t N>
+static void BM_OverwriteOldest(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, N>>();
+  int value = 0;
+  for (auto _ : state) {
+    c->push_back(value++);
+    benchmark::DoNotOptimize(c->back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<std::size_t N>
+static void BM_CheckFullThenPush(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, N>>();
+  int value = 0;
+  for (auto _ : state) {
+    if (c->full()) {
+      c->pop_front(); // the consumer side, to keep the ring full
+    } else {
+      c->push_back(value++);
+    }
+    benchmark::DoNotOptimize(c->size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<std::size_t N>
+static void BM_RejectWhenFull(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, N, vfc::reject_when_full>>();
+  int value = 0;
+  for (auto _ : state) {
+    if (!c->push_back(value++)) {
+      c->pop_front();
+    }
+    benchmark::DoNotOptimize(c->size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<std::size_t N>
+static void BM_EvictToCallback(benchmark::State& state) {
+  std::uint64_t evicted = 0;
+  auto c = std::make_unique<vfc::CircularContainer<int, N, vfc::evict_to<counting_sink>>>(
+    vfc::evict_to<counting_sink>{{&evicted}});
+  int value = 0;
+  for (auto _ : state) {
+    c->push_back(value++);
+    benchmark::DoNotOptimize(c->back());
+  }
+  benchmark::DoNotOptimize(evicted);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_OverwriteOldest, kCapacity);
+BENCHMARK_TEMPLATE(BM_OverwriteOldest, kOddCapacity);
+BENCHMARK_TEMPLATE(BM_CheckFullThenPush, kCapacity);
+BENCHMARK_TEMPLATE(BM_RejectWhenFull, kCapacity);
+BENCHMARK_TEMPLATE(BM_EvictToCallback, kCapacity);
+BENCHMARK_TEMPLATE(BM_EvictToCallback, kOddCapacity);
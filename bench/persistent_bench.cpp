@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "PersistentCircularContainer.hpp"
+
+// Startup and push_back cost of PersistentCircularContainer.
+//  - Reopen: open a full ring of 256 MiB, 1 GiB and 4 GiB and read its back().
+//    Only the header and the touched pages are read, so the time should not
+//    grow with the size of the ring.
+//  - Reload: what a ring saved as a plain file costs to start from, reading
+//    every element back into memory (up to 1 GiB, from the page cache, so it
+//    is a lower bound on reading from disk).
+//  - PushBack: push_back into a 64 MiB ring without syncing (the kernel writes
+//    the pages back) and with msync every 1, 64 and 4096 elements.
+// The ring files are created in the current directory and removed at exit.
+
+namespace {
+struct Event {
+  std::uint64_t id;
+  double value;
+};
+
+constexpr std::size_t kMiB = std::size_t{1} << 20;
+
+std::string ring_path(std::size_t bytes) {
+  return "persistent_bench_" + std::to_string(bytes / kMiB) + "MiB.ring";
+}
+
+// Creates a full ring file of the given size once per run.
+const std::string& full_ring(std::size_t bytes) {
+  static std::vector<std::unique_ptr<std::string>> paths;
+  for (const auto& path : paths) {
+    if (*path == ring_path(bytes)) {
+      return *path;
+    }
+  }
+  paths.push_back(std::make_unique<std::string>(ring_path(bytes)));
+  const std::string& path = *paths.back();
+  std::remove(path.c_str());
+  vfc::PersistentCircularContainer<Event> ring(path, bytes / sizeof(Event));
+  for (std::uint64_t i = 0; i < ring.capacity(); ++i) {
+    ring.push_back(Event{i, static_cast<double>(i)});
+  }
+  static const struct cleanup {
+    ~cleanup() {
+      for (const auto& path : paths) {
+        std::remove(path->c_str());
+      }
+    }
+  } remove_files;
+  return path;
+}
+}
+
+static void BM_Reopen(benchmark::State& state) {
+  const std::size_t bytes = static_cast<std::size_t>(state.range(0)) * kMiB;
+  const std::string& path = full_ring(bytes);
+  for (auto _ : state) {
+    vfc::PersistentCircularContainer<Event> ring(path, 0);
+    benchmark::DoNotOptimize(ring.back().id);
+  }
+  state.counters["elements"] = static_cast<double>(bytes / sizeof(Event));
+}
+BENCHMARK(BM_Reopen)->ArgName("MiB")->Arg(256)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_Reload(benchmark::State& state) {
+  const std::size_t bytes = static_cast<std::size_t>(state.range(0)) * kMiB;
+  const std::string& path = full_ring(bytes);
+  for (auto _ : state) {
+    std::vector<Event> events(bytes / sizeof(Event));
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    auto* out = reinterpret_cast<char*>(events.data());
+    // Skip the header page, then read the slots.
+    off_t offset = ::sysconf(_SC_PAGESIZE);
+    for (std::size_t done = 0; done < bytes;) {
+      const ssize_t n = ::pread(fd, out + done, bytes - done, offset);
+      if (n <= 0) {
+        break;
+      }
+      done += static_cast<std::size_t>(n);
+      offset += n;
+    }
+    ::close(fd);
+    benchmark::DoNotOptimize(events.back().id);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_Reload)->ArgName("MiB")->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_PushBack(benchmark::State& state) {
+  const std::string path = "persistent_bench_push.ring";
+  std::remove(path.c_str());
+  {
+    vfc::PersistentCircularContainer<Event> ring(path, 64 * kMiB / sizeof(Event));
+    ring.set_sync_interval(static_cast<std::size_t>(state.range(0)));
+    std::uint64_t id = 0;
+    for (auto _ : state) {
+      ring.push_back(Event{id, static_cast<double>(id)});
+      ++id;
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_PushBack)->ArgName("sync_every")->Arg(0)->Arg(1)->Arg(64)->Arg(4096);
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include "CircularContainer.hpp"
+
+// Compares the power-of-two layout (mask indexing, free-running counters)
+// against the modulo layout at the neighbouring non power-of-two capacity.
+
+template<std::size_t N>
+static void BM_PushBack(benchmark::State& state) {
+  vfc::CircularContainer<int, N> c;
+  int value = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < N; ++i) {
+      c.push_back(value++);
+    }
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<std::size_t N>
+static void BM_PushPop(benchmark::State& state) {
+  vfc::CircularContainer<int, N> c;
+  int value = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < N / 2; ++i) {
+      c.push_back(value++);
+    }
+    for (std::size_t i = 0; i < N / 2; ++i) {
+      benchmark::DoNotOptimize(c.front());
+      c.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template<std::size_t N>
+static void BM_Iterate(benchmark::State& state) {
+  vfc::CircularContainer<int, N> c;
+  for (std::size_t i = 0; i < N + N / 2; ++i) {
+    c.push_back(static_cast<int>(i));
+  }
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = c.begin(); it != c.end(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK_TEMPLATE(BM_PushBack, 1023);
+BENCHMARK_TEMPLATE(BM_PushBack, 1024);
+BENCHMARK_TEMPLATE(BM_PushBack, 65535);
+BENCHMARK_TEMPLATE(BM_PushBack, 65536);
+BENCHMARK_TEMPLATE(BM_PushPop, 1023);
+BENCHMARK_TEMPLATE(BM_PushPop, 1024);
+BENCHMARK_TEMPLATE(BM_PushPop, 65535);
+BENCHMARK_TEMPLATE(BM_PushPop, 65536);
+BENCHMARK_TEMPLATE(BM_Iterate, 1023);
+BENCHMARK_TEMPLATE(BM_Iterate, 1024);
+BENCHMARK_TEMPLATE(BM_Iterate, 65535);
+BENCHMARK_TEMPLATE(BM_Iterate, 65536);
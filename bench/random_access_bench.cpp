@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+#include "CircularContainer.hpp"
+
+// std::sort, std::lower_bound and std::distance through the random-access
+// iterators, against the previous bidirectional iterators (emulated by an
+// adaptor that hides everything but ++/--). std::sort did not compile with
+// bidirectional iterators, so its baseline is sorting a copy and writing it
+// back. 50000 exercises the spare-slot layout, 65536 the power-of-two one.
+
+namespace {
+
+template<typename It>
+class bidirectional_adaptor {
+  public:
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using pointer = typename std::iterator_traits<It>::pointer;
+    using reference = typename std::iterator_traits<It>::reference;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    explicit bidirectional_adaptor(It it) : m_it(it) {}
+
+    reference operator*() { return *m_it; }
+    bidirectional_adaptor& operator++() { ++m_it; return *this; }
+    bidirectional_adaptor& operator--() { --m_it; return *this; }
+    bool operator==(const bidirectional_adaptor& other) const { return m_it == other.m_it; }
+    bool operator!=(const bidirectional_adaptor& other) const { return m_it != other.m_it; }
+
+  private:
+    It m_it;
+};
+
+template<typename Container>
+void fill_shuffled(Container& c, std::size_t count) {
+  std::vector<int> values(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    values[i] = static_cast<int>(i);
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937(42));
+  // Push past the capacity once so the contents wrap around the buffer end.
+  for (std::size_t i = 0; i < count / 2; ++i) {
+    c.push_back(0);
+  }
+  for (int v : values) {
+    c.push_back(v);
+  }
+}
+}
+
+template<std::size_t kCapacity>
+static void BM_SortRandomAccess(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    fill_shuffled(*c, kCapacity);
+    state.ResumeTiming();
+    std::sort(c->begin(), c->end());
+    benchmark::DoNotOptimize(c->front());
+  }
+  state.SetItemsProcessed(state.iterations() * kCapacity);
+}
+BENCHMARK_TEMPLATE(BM_SortRandomAccess, 50000);
+BENCHMARK_TEMPLATE(BM_SortRandomAccess, 65536);
+
+template<std::size_t kCapacity>
+static void BM_SortViaCopy(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  std::vector<int> scratch;
+  for (auto _ : state) {
+    state.PauseTiming();
+    fill_shuffled(*c, kCapacity);
+    state.ResumeTiming();
+    scratch.assign(c->begin(), c->end());
+    std::sort(scratch.begin(), scratch.end());
+    std::copy(scratch.begin(), scratch.end(), c->begin());
+    benchmark::DoNotOptimize(c->front());
+  }
+  state.SetItemsProcessed(state.iterations() * kCapacity);
+}
+BENCHMARK_TEMPLATE(BM_SortViaCopy, 50000);
+BENCHMARK_TEMPLATE(BM_SortViaCopy, 65536);
+
+template<std::size_t kCapacity>
+static void BM_LowerBoundRandomAccess(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  fill_shuffled(*c, kCapacity);
+  std::sort(c->begin(), c->end());
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::lower_bound(c->begin(), c->end(), key));
+    key = (key + 7919) % static_cast<int>(kCapacity);
+  }
+}
+BENCHMARK_TEMPLATE(BM_LowerBoundRandomAccess, 50000);
+BENCHMARK_TEMPLATE(BM_LowerBoundRandomAccess, 65536);
+
+template<std::size_t kCapacity>
+static void BM_LowerBoundBidirectional(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  fill_shuffled(*c, kCapacity);
+  std::sort(c->begin(), c->end());
+  using adaptor = bidirectional_adaptor<typename vfc::CircularContainer<int, kCapacity>::iterator>;
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::lower_bound(adaptor(c->begin()), adaptor(c->end()), key));
+    key = (key + 7919) % static_cast<int>(kCapacity);
+  }
+}
+BENCHMARK_TEMPLATE(BM_LowerBoundBidirectional, 50000);
+BENCHMARK_TEMPLATE(BM_LowerBoundBidirectional, 65536);
+
+template<std::size_t kCapacity>
+static void BM_DistanceRandomAccess(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  fill_shuffled(*c, kCapacity);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::distance(c->begin(), c->end()));
+  }
+}
+BENCHMARK_TEMPLATE(BM_DistanceRandomAccess, 50000);
+BENCHMARK_TEMPLATE(BM_DistanceRandomAccess, 65536);
+
+template<std::size_t kCapacity>
+static void BM_DistanceBidirectional(benchmark::State& state) {
+  auto c = std::make_unique<vfc::CircularContainer<int, kCapacity>>();
+  fill_shuffled(*c, kCapacity);
+  using adaptor = bidirectional_adaptor<typename vfc::CircularContainer<int, kCapacity>::iterator>;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::distance(adaptor(c->begin()), adaptor(c->end())));
+  }
+}
+BENCHMARK_TEMPLATE(BM_DistanceBidirectional, 50000);
+BENCHMARK_TEMPLATE(BM_DistanceBidirectional, 65536);
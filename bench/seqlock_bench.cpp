@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CircularContainer.hpp"
+#include "SeqlockCircularContainer.hpp"
+
+// Writer latency of SeqlockCircularContainer with 0, 1 and 8 reader threads
+// polling the latest kWindow samples, against a CircularContainer behind a
+// mutex that the writer and the readers share. Every push is timed with
+// steady_clock (whose own cost is included) and the p50/p99/p99.9/max
+// latencies are reported as counters; readers_copies is how many windows
+// the readers got per push.
+
+namespace {
+constexpr std::size_t kCapacity = 4096;
+constexpr std::size_t kWindow = 64;
+constexpr std::size_t kMaxSamples = std::size_t{1} << 20;
+
+struct Sample {
+  std::uint64_t timestamp;
+  double value;
+};
+
+class LockedRing {
+  public:
+    void push_back(const Sample& item) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_ring.push_back(item);
+    }
+
+    std::size_t latest(std::size_t count, Sample* out) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      count = std::min(count, m_ring.size());
+      std::copy(m_ring.end() - static_cast<std::ptrdiff_t>(count), m_ring.end(), out);
+      return count;
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    vfc::CircularContainer<Sample, kCapacity> m_ring;
+};
+
+template<typename Ring>
+void run_writer(benchmark::State& state) {
+  auto ring = std::make_unique<Ring>();
+  const auto reader_count = static_cast<int>(state.range(0));
+  std::atomic<bool> done{false};
+  std::atomic<std::uint64_t> copies{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < reader_count; ++r) {
+    readers.emplace_back([&] {
+      Sample window[kWindow];
+      std::uint64_t local = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        benchmark::DoNotOptimize(ring->latest(kWindow, window));
+        ++local;
+      }
+      copies.fetch_add(local);
+    });
+  }
+
+  std::vector<std::int64_t> latencies;
+  latencies.reserve(kMaxSamples);
+  std::uint64_t pushed = 0;
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    ring->push_back(Sample{pushed, static_cast<double>(pushed)});
+    const auto stop = std::chrono::steady_clock::now();
+    if (latencies.size() < kMaxSamples) {
+      latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    }
+    ++pushed;
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&](double p) {
+    return latencies.empty() ? 0.0
+                             : static_cast<double>(latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]);
+  };
+  state.counters["p50_ns"] = percentile(0.5);
+  state.counters["p99_ns"] = percentile(0.99);
+  state.counters["p999_ns"] = percentile(0.999);
+  state.counters["max_ns"] = percentile(1.0);
+  state.counters["reader_copies"] = benchmark::Counter(static_cast<double>(copies.load()) / static_cast<double>(pushed));
+  state.SetItemsProcessed(state.iterations());
+}
+}
+
+static void BM_SeqlockWriter(benchmark::State& state) {
+  run_writer<vfc::SeqlockCircularContainer<Sample, kCapacity>>(state);
+}
+BENCHMARK(BM_SeqlockWriter)->ArgName("readers")->Arg(0)->Arg(1)->Arg(8)->UseRealTime();
+
+static void BM_MutexWriter(benchmark::State& state) {
+  run_writer<LockedRing>(state);
+}
+BENCHMARK(BM_MutexWriter)->ArgName("readers")->Arg(0)->Arg(1)->Arg(8)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+#include "SpscCircularContainer.hpp"
+#include "bench_common.hpp"
+
+// Two-thread throughput and round-trip latency of SpscCircularContainer,
+// against a CircularContainer guarded by a mutex.
+
+namespace {
+constexpr std::size_t kCapacity = 1024;
+constexpr int kBatch = 4096;
+
+vfc::SpscCircularContainer<int, kCapacity> spsc_queue;
+bench::LockedCircularContainer<int, kCapacity> locked_queue;
+
+// Thread 0 produces, thread 1 consumes; both run the same number of iterations.
+template<typename Queue>
+void run_throughput(benchmark::State& state, Queue& queue) {
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      for (int i = 0; i < kBatch; ++i) {
+        bench::push_spin(queue, i);
+      }
+    } else {
+      int item;
+      for (int i = 0; i < kBatch; ++i) {
+        bench::pop_spin(queue, item);
+        benchmark::DoNotOptimize(item);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+}
+
+static void BM_SpscThroughput(benchmark::State& state) {
+  run_throughput(state, spsc_queue);
+}
+BENCHMARK(BM_SpscThroughput)->Threads(2)->UseRealTime();
+
+static void BM_MutexThroughput(benchmark::State& state) {
+  run_throughput(state, locked_queue);
+}
+BENCHMARK(BM_MutexThroughput)->Threads(2)->UseRealTime();
+
+// Round trip: send a value to an echo thread and wait for it to come back.
+static void BM_SpscRoundTrip(benchmark::State& state) {
+  vfc::SpscCircularContainer<int, 16> ping;
+  vfc::SpscCircularContainer<int, 16> pong;
+  std::atomic<bool> done{false};
+  std::thread echo([&] {
+    int item;
+    while (!done.load(std::memory_order_relaxed)) {
+      if (ping.try_pop(item)) {
+        bench::push_spin(pong, item);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int value = 0;
+  for (auto _ : state) {
+    bench::push_spin(ping, value);
+    int item;
+    bench::pop_spin(pong, item);
+    benchmark::DoNotOptimize(item);
+    ++value;
+  }
+  done.store(true, std::memory_order_relaxed);
+  echo.join();
+}
+BENCHMARK(BM_SpscRoundTrip)->UseRealTime();
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "CircularContainer.hpp"
+#include "MpmcCircularContainer.hpp"
+
+// Cost of the stats policies on the hot paths: no_stats (the default, which
+// must match the plain container), count_stats and atomic_stats, for
+// push_back on a full ring (every push overwrites), a push_back/pop_front
+// pair and a middle insert. The MPMC ring is compared with and without
+// atomic_stats on a single thread.
+
+namespace {
+constexpr std::size_t kCapacity = 1024;
+
+template<typename Stats>
+using Ring = vfc::CircularContainer<int, kCapacity, vfc::overwrite_oldest, vfc::compact_layout, Stats>;
+
+static_assert(sizeof(Ring<vfc::no_stats>) == sizeof(vfc::CircularContainer<int, kCapacity>));
+}
+
+template<typename Stats>
+static void BM_PushBackOverwrite(benchmark::State& state) {
+  auto c = std::make_unique<Ring<Stats>>();
+  int value = 0;
+  for (auto _ : state) {
+    c->push_back(value++);
+    benchmark::DoNotOptimize(c->back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Stats>
+static void BM_PushPop(benchmark::State& state) {
+  auto c = std::make_unique<Ring<Stats>>();
+  for (std::size_t i = 0; i < kCapacity / 2; ++i) {
+    c->push_back(static_cast<int>(i));
+  }
+  int value = 0;
+  for (auto _ : state) {
+    c->push_back(value++);
+    c->pop_front();
+    benchmark::DoNotOptimize(c->size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Stats>
+static void BM_InsertMiddle(benchmark::State& state) {
+  auto c = std::make_unique<Ring<Stats>>();
+  for (std::size_t i = 0; i < kCapacity; ++i) {
+    c->push_back(static_cast<int>(i));
+  }
+  int value = 0;
+  for (auto _ : state) {
+    c->insert(c->begin() + kCapacity / 2, value++);
+    benchmark::DoNotOptimize(c->size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Stats>
+static void BM_MpmcPushPop(benchmark::State& state) {
+  auto q = std::make_unique<vfc::MpmcCircularContainer<int, kCapacity, Stats>>();
+  int value = 0;
+  int item = 0;
+  for (auto _ : state) {
+    q->try_push(value++);
+    q->try_pop(item);
+    benchmark::DoNotOptimize(item);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, vfc::no_stats);
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, vfc::count_stats);
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, vfc::atomic_stats);
+BENCHMARK_TEMPLATE(BM_PushPop, vfc::no_stats);
+BENCHMARK_TEMPLATE(BM_PushPop, vfc::count_stats);
+BENCHMARK_TEMPLATE(BM_PushPop, vfc::atomic_stats);
+BENCHMARK_TEMPLATE(BM_InsertMiddle, vfc::no_stats);
+BENCHMARK_TEMPLATE(BM_InsertMiddle, vfc::count_stats);
+BENCHMARK_TEMPLATE(BM_InsertMiddle, vfc::atomic_stats);
+BENCHMARK_TEMPLATE(BM_MpmcPushPop, vfc::no_stats);
+BENCHMARK_TEMPLATE(BM_MpmcPushPop, vfc::atomic_stats);
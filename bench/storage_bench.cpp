@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <malloc.h>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include "CircularContainer.hpp"
+
+// Construction cost and memory footprint of the uninitialized storage, against
+// the previous layout, which default-constructed a std::array of
+// _capacity + 1 elements and never destroyed popped ones.
+
+namespace {
+std::atomic<std::size_t> heap_in_use{0};
+
+const std::string kLongString(64, 'x'); // too long for the small-string buffer
+}
+
+void* operator new(std::size_t size) {
+  void* p = std::malloc(size);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  heap_in_use += malloc_usable_size(p);
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  if (p) {
+    heap_in_use -= malloc_usable_size(p);
+    std::free(p);
+  }
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  operator delete(p);
+}
+
+template<std::size_t N>
+static void BM_ConstructRing(benchmark::State& state) {
+  for (auto _ : state) {
+    auto c = std::make_unique<vfc::CircularContainer<std::string, N>>();
+    benchmark::DoNotOptimize(c.get());
+  }
+  state.counters["object_bytes"] = sizeof(vfc::CircularContainer<std::string, N>);
+}
+
+template<std::size_t N>
+static void BM_ConstructArrayBaseline(benchmark::State& state) {
+  for (auto _ : state) {
+    auto a = std::make_unique<std::array<std::string, N + 1>>();
+    benchmark::DoNotOptimize(a.get());
+  }
+  state.counters["object_bytes"] = sizeof(std::array<std::string, N + 1>);
+}
+
+// Heap still held after filling the ring with heap-allocated strings and
+// popping every element.
+template<std::size_t N>
+static void BM_HeapAfterPopRing(benchmark::State& state) {
+  std::size_t retained = 0;
+  for (auto _ : state) {
+    auto c = std::make_unique<vfc::CircularContainer<std::string, N>>();
+    const std::size_t before = heap_in_use;
+    for (std::size_t i = 0; i < N; ++i) {
+      c->push_back(kLongString);
+    }
+    while (!c->empty()) {
+      c->pop_front();
+    }
+    retained = heap_in_use - before;
+  }
+  state.counters["heap_bytes_after_pop"] = static_cast<double>(retained);
+}
+
+template<std::size_t N>
+static void BM_HeapAfterPopArrayBaseline(benchmark::State& state) {
+  std::size_t retained = 0;
+  for (auto _ : state) {
+    auto a = std::make_unique<std::array<std::string, N + 1>>();
+    const std::size_t before = heap_in_use;
+    for (std::size_t i = 0; i < N; ++i) {
+      (*a)[i] = kLongString; // popping only moved an index
+    }
+    retained = heap_in_use - before;
+  }
+  state.counters["heap_bytes_after_pop"] = static_cast<double>(retained);
+}
+
+BENCHMARK_TEMPLATE(BM_ConstructRing, 1000);
+BENCHMARK_TEMPLATE(BM_ConstructRing, 100000);
+BENCHMARK_TEMPLATE(BM_ConstructArrayBaseline, 1000);
+BENCHMARK_TEMPLATE(BM_ConstructArrayBaseline, 100000);
+BENCHMARK_TEMPLATE(BM_HeapAfterPopRing, 100000);
+BENCHMARK_TEMPLATE(BM_HeapAfterPopArrayBaseline, 100000);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "CircularContainer.hpp"
+#include "WindowedCircularContainer.hpp"
+
+// Per-tick cost of maintaining sum, mean, min and max over a sliding window
+// of samples: incrementally (WindowedCircularContainer) against pushing into
+// a CircularContainer and rescanning the whole window every tick.
+
+namespace {
+const std::vector<double>& samples() {
+  static const std::vector<double> values = [] {
+    std::vector<double> out(1 << 16);
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(100.0, 15.0);
+    for (auto& v : out) {
+      v = noise(rng);
+    }
+    return out;
+  }();
+  return values;
+}
+}
+
+template<std::size_t N>
+static void BM_Incremental(benchmark::State& state) {
+  const auto& values = samples();
+  auto window = std::make_unique<
+    vfc::WindowedCircularContainer<double, N, vfc::window_sum, vfc::window_variance, vfc::window_min, vfc::window_max>>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    window->push_back(values[i++ & (values.size() - 1)]);
+    benchmark::DoNotOptimize(window->sum());
+    benchmark::DoNotOptimize(window->mean());
+    benchmark::DoNotOptimize(window->min());
+    benchmark::DoNotOptimize(window->max());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<std::size_t N>
+static void BM_Rescan(benchmark::State& state) {
+  const auto& values = samples();
+  auto window = std::make_unique<vfc::CircularContainer<double, N>>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    window->push_back(values[i++ & (values.size() - 1)]);
+    double sum = 0.0;
+    double lo = window->front();
+    double hi = lo;
+    for (double v : *window) {
+      sum += v;
+      lo = std::min(lo, v);
+      hi = std::max(hi, v);
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(sum / static_cast<double>(window->size()));
+    benchmark::DoNotOptimize(lo);
+    benchmark::DoNotOptimize(hi);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Incremental, 16);
+BENCHMARK_TEMPLATE(BM_Incremental, 256);
+BENCHMARK_TEMPLATE(BM_Incremental, 4096);
+BENCHMARK_TEMPLATE(BM_Incremental, 65536);
+BENCHMARK_TEMPLATE(BM_Rescan, 16);
+BENCHMARK_TEMPLATE(BM_Rescan, 256);
+BENCHMARK_TEMPLATE(BM_Rescan, 4096);
+BENCHMARK_TEMPLATE(BM_Rescan, 65536);
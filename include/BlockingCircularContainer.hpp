@@ -0,0 +1,274 @@
+#ifndef BLOCKINGCIRCULARCONTAINER_H_
+#define BLOCKINGCIRCULARCONTAINER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include "MpmcCircularContainer.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <algorithm>
+#endif
+
+#if defined(__linux__) || defined(__cpp_lib_atomic_wait)
+
+namespace vfc {
+namespace detail {
+// Blocking on a 32-bit event word: the sleeper passes the value it last saw
+// and returns when the word changed, on a wake, spuriously or on timeout, so
+// callers always re-check their condition. Linux uses the futex directly,
+// which also gives the timed wait that std::atomic::wait lacks (and whose
+// notify would not see waiters it did not register itself); elsewhere
+// std::atomic::wait/notify are used and timed waits sleep in short slices.
+#if defined(__linux__)
+inline long futex(std::atomic<std::uint32_t>& word, int op, std::uint32_t value, const timespec* timeout) noexcept {
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+  return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op | FUTEX_PRIVATE_FLAG, value, timeout,
+                   nullptr, 0);
+}
+
+inline void event_wait(std::atomic<std::uint32_t>& word, std::uint32_t seen) noexcept {
+  futex(word, FUTEX_WAIT, seen, nullptr);
+}
+
+inline void event_wait_for(std::atomic<std::uint32_t>& word, std::uint32_t seen,
+                           std::chrono::nanoseconds timeout) noexcept {
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  timespec relative{};
+  relative.tv_sec = static_cast<std::time_t>(seconds.count());
+  relative.tv_nsec = static_cast<long>((timeout - seconds).count());
+  futex(word, FUTEX_WAIT, seen, &relative);
+}
+
+inline void event_notify_one(std::atomic<std::uint32_t>& word) noexcept {
+  futex(word, FUTEX_WAKE, 1, nullptr);
+}
+
+inline void event_notify_all(std::atomic<std::uint32_t>& word) noexcept {
+  futex(word, FUTEX_WAKE, INT_MAX, nullptr);
+}
+#else
+inline void event_wait(std::atomic<std::uint32_t>& word, std::uint32_t seen) noexcept {
+  word.wait(seen);
+}
+
+inline void event_wait_for(std::atomic<std::uint32_t>& word, std::uint32_t seen,
+                           std::chrono::nanoseconds timeout) noexcept {
+  if (word.load() == seen) {
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(50)));
+  }
+}
+
+inline void event_notify_one(std::atomic<std::uint32_t>& word) noexcept {
+  word.notify_one();
+}
+
+inline void event_notify_all(std::atomic<std::uint32_t>& word) noexcept {
+  word.notify_all();
+}
+#endif
+} // namespace detail
+
+// Bounded multi-producer/multi-consumer channel on an MpmcCircularContainer.
+// push_wait blocks while the ring is full and pop_wait while it is empty.
+// Both sides first try the lock-free ring; a thread that has to sleep arms
+// the event it sleeps on (low bit of the word) before its last retry, and
+// only the first push or pop to find the event armed disarms it and makes the
+// wake-up system call, i.e. once per empty->non-empty or full->non-full
+// transition that somebody waits for. An uncontended push or pop never enters
+// the kernel, and only checks the armed bit with a plain load.
+//
+// A wake-up releases every sleeper on that side; the ones that lose the race
+// for the element re-arm and sleep again.
+//
+// close() wakes everyone: pushes fail from then on, and pops drain the
+// remaining elements before failing.
+template<typename Tp, std::size_t _capacity>
+class BlockingCircularContainer {
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    BlockingCircularContainer() = default;
+    BlockingCircularContainer(const BlockingCircularContainer& other) = delete;
+    BlockingCircularContainer& operator=(const BlockingCircularContainer& other) = delete;
+    ~BlockingCircularContainer() = default;
+
+    // Producers:
+    // Waits for a free slot; returns false (and leaves item alone) once closed.
+    bool push_wait(const value_type& item) {
+      return block(m_not_full, nullptr, [&] { return try_push(item); }, [&] { return has_room(); });
+    }
+
+    bool push_wait(value_type&& item) {
+      return block(m_not_full, nullptr, [&] { return try_push(std::move(item)); }, [&] { return has_room(); });
+    }
+
+    bool try_push(const value_type& item) {
+      return try_emplace(item);
+    }
+
+    bool try_push(value_type&& item) {
+      return try_emplace(std::move(item));
+    }
+
+    // Fails on a full or closed channel; args are only used on success.
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+      if (closed() || !m_ring.try_emplace(std::forward<Args>(args)...)) {
+        return false;
+      }
+      wake(m_not_empty);
+      return true;
+    }
+
+    // Consumers:
+    // Waits for an element; returns false once closed and drained.
+    bool pop_wait(value_type& item) {
+      return block(m_not_empty, nullptr, [&] { return try_pop(item); }, [&] { return !m_ring.empty(); });
+    }
+
+    // As pop_wait, but also returns false if no element arrived within timeout.
+    // A timeout too long for steady_clock (e.g. duration::max()) waits forever.
+    template<typename Rep, typename Period>
+    bool pop_wait_for(value_type& item, const std::chrono::duration<Rep, Period>& timeout) {
+      const time_point deadline = deadline_after(timeout);
+      return block(m_not_empty, &deadline, [&] { return try_pop(item); }, [&] { return !m_ring.empty(); });
+    }
+
+    bool try_pop(value_type& item) {
+      if (!m_ring.try_pop(item)) {
+        return false;
+      }
+      wake(m_not_full);
+      return true;
+    }
+
+    // Wakes every waiter; see the class comment.
+    void close() {
+      m_closed.store(true);
+      for (auto* event : {&m_not_empty, &m_not_full}) {
+        event->fetch_add(2); // keeps the armed bit
+        detail::event_notify_all(*event);
+      }
+    }
+
+    [[nodiscard]] bool closed() const noexcept {
+      return m_closed.load(std::memory_order_acquire);
+    }
+
+    // Capacity (size() and empty() are only a snapshot when other threads are active):
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+      return _capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      return m_ring.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return m_ring.empty();
+    }
+
+  private:
+    using event_word = std::atomic<std::uint32_t>;
+    using time_point = std::chrono::steady_clock::time_point;
+
+    // now() + timeout, saturated at time_point::max() instead of overflowing.
+    template<typename Rep, typename Period>
+    static time_point deadline_after(const std::chrono::duration<Rep, Period>& timeout) {
+      const time_point now = std::chrono::steady_clock::now();
+      if (timeout <= timeout.zero()) {
+        return now;
+      }
+      const std::chrono::duration<double> left = time_point::max() - now;
+      if (std::chrono::duration<double>(timeout) >= left) {
+        return time_point::max();
+      }
+      return now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    }
+
+    [[nodiscard]] bool has_room() const noexcept {
+      return m_ring.size() < _capacity;
+    }
+
+    // Runs attempt() until it succeeds, sleeping on event in between. Before
+    // sleeping the thread arms event and checks ready(), which reads the
+    // ring's position counters: either it sees the slot the other side
+    // claimed, or the other side's wake() sees the armed bit and bumps event.
+    // The claim is a seq_cst CAS and wake() a seq_cst load, so the sleeper's
+    // fence is the only one needed. When ready() holds but the element (or
+    // slot) is not published yet, the thread yields and tries again. After
+    // close() there is one last attempt (a pop may still drain an element).
+    template<typename Attempt, typename Ready>
+    bool block(event_word& event, const time_point* deadline, Attempt attempt, Ready ready) {
+      for (;;) {
+        if (attempt()) {
+          return true;
+        }
+        if (closed()) {
+          return attempt();
+        }
+        auto timeout = std::chrono::nanoseconds::max();
+        if (deadline) {
+          const auto now = std::chrono::steady_clock::now();
+          if (now >= *deadline) {
+            return false;
+          }
+          timeout = *deadline - now;
+        }
+        const std::uint32_t seen = event.fetch_or(armed) | armed;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (closed()) {
+          continue;
+        }
+        if (ready()) {
+          std::this_thread::yield();
+          continue;
+        }
+        if (deadline) {
+          detail::event_wait_for(event, seen, timeout);
+        } else {
+          detail::event_wait(event, seen);
+        }
+      }
+    }
+
+    // Called after the element count changed: if event is armed, disarms it
+    // and wakes its sleepers. Disarming an odd word with +1 also changes the
+    // value, so a thread about to sleep on the armed value returns at once.
+    static void wake(event_word& event) {
+      std::uint32_t word = event.load(std::memory_order_seq_cst);
+      while (word & armed) {
+        if (event.compare_exchange_weak(word, word + 1)) {
+          detail::event_notify_all(event);
+          return;
+        }
+      }
+    }
+
+    static constexpr std::uint32_t armed = 1;
+
+    MpmcCircularContainer<Tp, _capacity> m_ring;
+    std::atomic<bool> m_closed{false};
+
+    // Consumers sleep on m_not_empty, producers on m_not_full.
+    alignas(detail::cache_line_size) event_word m_not_empty{0};
+    alignas(detail::cache_line_size) event_word m_not_full{0};
+};
+}
+
+#endif // __linux__ || __cpp_lib_atomic_wait
+
+#endif // BLOCKINGCIRCULARCONTAINER_H_
@@ -0,0 +1,360 @@
+#ifndef CIRCULARALGORITHMS_H_
+#define CIRCULARALGORITHMS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "CircularContainer.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VFC_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define VFC_X86_SIMD 0
+#endif
+
+namespace vfc {
+namespace simd {
+// Instruction sets the algorithms below can use, in increasing order.
+enum class simd_level { scalar, sse4_1, avx2 };
+
+// Best level supported by the running CPU, detected once.
+inline simd_level detected_simd_level() noexcept {
+#if VFC_X86_SIMD
+  static const simd_level level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return simd_level::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+      return simd_level::sse4_1;
+    }
+    return simd_level::scalar;
+  }();
+  return level;
+#else
+  return simd_level::scalar;
+#endif
+}
+
+namespace detail {
+#if VFC_X86_SIMD
+// Each instruction set gets its own traits and its own copy of the kernels,
+// compiled for that target only, so the header needs no special flags.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse4.1"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+namespace sse4_1 {
+template<typename T>
+struct traits;
+
+template<>
+struct traits<float> {
+  using reg = __m128;
+  static constexpr std::size_t width = 4;
+  static reg load(const float* p) { return _mm_loadu_ps(p); }
+  static void store(float* p, reg a) { _mm_storeu_ps(p, a); }
+  static reg set1(float v) { return _mm_set1_ps(v); }
+  static reg zero() { return _mm_setzero_ps(); }
+  static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+  static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+  static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+  static int eq(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+  static int gt(reg a, reg b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+};
+
+template<>
+struct traits<double> {
+  using reg = __m128d;
+  static constexpr std::size_t width = 2;
+  static reg load(const double* p) { return _mm_loadu_pd(p); }
+  static void store(double* p, reg a) { _mm_storeu_pd(p, a); }
+  static reg set1(double v) { return _mm_set1_pd(v); }
+  static reg zero() { return _mm_setzero_pd(); }
+  static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+  static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+  static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+  static int eq(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+  static int gt(reg a, reg b) { return _mm_movemask_pd(_mm_cmpgt_pd(a, b)); }
+};
+
+template<>
+struct traits<std::int32_t> {
+  using reg = __m128i;
+  static constexpr std::size_t width = 4;
+  static reg load(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  static void store(std::int32_t* p, reg a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+  static reg set1(std::int32_t v) { return _mm_set1_epi32(v); }
+  static reg zero() { return _mm_setzero_si128(); }
+  static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+  static reg mul(reg a, reg b) { return _mm_mullo_epi32(a, b); }
+  static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+  static int eq(reg a, reg b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+  static int gt(reg a, reg b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b))); }
+};
+
+#include "CircularSimdKernels.inc"
+} // namespace sse4_1
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+namespace avx2 {
+template<typename T>
+struct traits;
+
+template<>
+struct traits<float> {
+  using reg = __m256;
+  static constexpr std::size_t width = 8;
+  static reg load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, reg a) { _mm256_storeu_ps(p, a); }
+  static reg set1(float v) { return _mm256_set1_ps(v); }
+  static reg zero() { return _mm256_setzero_ps(); }
+  static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+  static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+  static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+  static int eq(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+  static int gt(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+};
+
+template<>
+struct traits<double> {
+  using reg = __m256d;
+  static constexpr std::size_t width = 4;
+  static reg load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, reg a) { _mm256_storeu_pd(p, a); }
+  static reg set1(double v) { return _mm256_set1_pd(v); }
+  static reg zero() { return _mm256_setzero_pd(); }
+  static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+  static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+  static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+  static int eq(reg a, reg b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+  static int gt(reg a, reg b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+};
+
+template<>
+struct traits<std::int32_t> {
+  using reg = __m256i;
+  static constexpr std::size_t width = 8;
+  static reg load(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  static void store(std::int32_t* p, reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+  static reg set1(std::int32_t v) { return _mm256_set1_epi32(v); }
+  static reg zero() { return _mm256_setzero_si256(); }
+  static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+  static reg mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+  static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+  static int eq(reg a, reg b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+  static int gt(reg a, reg b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))); }
+};
+
+#include "CircularSimdKernels.inc"
+} // namespace avx2
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif // VFC_X86_SIMD
+
+// Element types with vector kernels; everything else uses the scalar loops.
+template<typename T>
+inline constexpr bool has_kernels_v =
+  std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>;
+
+#if VFC_X86_SIMD
+#define VFC_SIMD_DISPATCH(T, level, ...)                 \
+  if constexpr (has_kernels_v<T>) {                      \
+    if ((level) == simd_level::avx2) {                   \
+      return avx2::__VA_ARGS__;                          \
+    }                                                    \
+    if ((level) == simd_level::sse4_1) {                 \
+      return sse4_1::__VA_ARGS__;                        \
+    }                                                    \
+  }
+#else
+#define VFC_SIMD_DISPATCH(T, level, ...) (void)(level);
+#endif
+
+template<typename T>
+T run_sum(const T* data, std::size_t n, simd_level level) {
+  VFC_SIMD_DISPATCH(T, level, sum(data, n))
+  T total = T();
+  for (std::size_t i = 0; i < n; ++i) {
+    total += data[i];
+  }
+  return total;
+}
+
+template<typename T>
+T run_dot(const T* a, const T* b, std::size_t n, simd_level level) {
+  VFC_SIMD_DISPATCH(T, level, dot(a, b, n))
+  T total = T();
+  for (std::size_t i = 0; i < n; ++i) {
+    total += a[i] * b[i];
+  }
+  return total;
+}
+
+template<typename T>
+void run_min_max(const T* data, std::size_t n, T& lo, T& hi, simd_level level) {
+  VFC_SIMD_DISPATCH(T, level, min_max(data, n, lo, hi))
+  for (std::size_t i = 0; i < n; ++i) {
+    lo = std::min(lo, data[i]);
+    hi = std::max(hi, data[i]);
+  }
+}
+
+template<bool Above, typename T>
+std::size_t run_count(const T* data, std::size_t n, T value, simd_level level) {
+  VFC_SIMD_DISPATCH(T, level, template count_matches<T, Above>(data, n, value))
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    total += Above ? data[i] > value : data[i] == value;
+  }
+  return total;
+}
+
+template<bool Above, typename T>
+std::size_t run_find(const T* data, std::size_t n, T value, simd_level level) {
+  VFC_SIMD_DISPATCH(T, level, template find_match<T, Above>(data, n, value))
+  for (std::size_t i = 0; i < n; ++i) {
+    if (Above ? data[i] > value : data[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+#undef VFC_SIMD_DISPATCH
+
+template<typename Container>
+constexpr void check_arithmetic() {
+  static_assert(std::is_arithmetic_v<typename Container::value_type>,
+                "vfc::simd algorithms need an arithmetic value_type");
+}
+
+// Logical position of the first match in the container's two runs, or size().
+template<bool Above, typename Container>
+typename Container::size_type find_position(const Container& c, const typename Container::value_type& value,
+                                            simd_level level) {
+  const auto one = c.array_one();
+  const std::size_t first = run_find<Above>(one.first, one.second, value, level);
+  if (first != one.second) {
+    return first;
+  }
+  const auto two = c.array_two();
+  return one.second + run_find<Above>(two.first, two.second, value, level);
+}
+} // namespace detail
+
+// Container-aware algorithms for CircularContainer (and any container with
+// array_one()/array_two()) of arithmetic elements. They work on the two
+// contiguous runs of the buffer instead of stepping iterators, using the best
+// vector kernels for float, double and int32_t that the CPU supports (or the
+// given level, if lower) and scalar loops otherwise. Floating-point results
+// may differ from a sequential loop in the last bits because of the
+// summation order; integer sums wrap as in value_type.
+
+template<typename Container>
+typename Container::value_type sum(const Container& c, simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  level = std::min(level, detected_simd_level());
+  const auto one = c.array_one();
+  const auto two = c.array_two();
+  return detail::run_sum(one.first, one.second, level) + detail::run_sum(two.first, two.second, level);
+}
+
+// Sum of c[i] * weights[i]; weights must hold size() elements.
+template<typename Container>
+typename Container::value_type dot(const Container& c, const typename Container::value_type* weights,
+                                   simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  level = std::min(level, detected_simd_level());
+  const auto one = c.array_one();
+  const auto two = c.array_two();
+  return detail::run_dot(one.first, weights, one.second, level) +
+         detail::run_dot(two.first, weights + one.second, two.second, level);
+}
+
+// Smallest and largest element; throws std::out_of_range if c is empty.
+template<typename Container>
+std::pair<typename Container::value_type, typename Container::value_type>
+min_max(const Container& c, simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  if (c.empty()) {
+    throw std::out_of_range("vfc::simd::min_max() - container is empty");
+  }
+  level = std::min(level, detected_simd_level());
+  const auto one = c.array_one();
+  const auto two = c.array_two();
+  auto lo = *one.first;
+  auto hi = lo;
+  detail::run_min_max(one.first, one.second, lo, hi, level);
+  detail::run_min_max(two.first, two.second, lo, hi, level);
+  return {lo, hi};
+}
+
+template<typename Container>
+typename Container::size_type count(const Container& c, const typename Container::value_type& value,
+                                    simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  level = std::min(level, detected_simd_level());
+  const auto one = c.array_one();
+  const auto two = c.array_two();
+  return detail::run_count<false>(one.first, one.second, value, level) +
+         detail::run_count<false>(two.first, two.second, value, level);
+}
+
+// Number of elements greater than threshold.
+template<typename Container>
+typename Container::size_type count_above(const Container& c, const typename Container::value_type& threshold,
+                                          simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  level = std::min(level, detected_simd_level());
+  const auto one = c.array_one();
+  const auto two = c.array_two();
+  return detail::run_count<true>(one.first, one.second, threshold, level) +
+         detail::run_count<true>(two.first, two.second, threshold, level);
+}
+
+// First element equal to value, or end().
+template<typename Container>
+typename Container::const_iterator find(const Container& c, const typename Container::value_type& value,
+                                        simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  const auto position = detail::find_position<false>(c, value, std::min(level, detected_simd_level()));
+  return c.begin() + static_cast<typename Container::difference_type>(position);
+}
+
+// First element greater than threshold, or end().
+template<typename Container>
+typename Container::const_iterator find_above(const Container& c, const typename Container::value_type& threshold,
+                                              simd_level level = detected_simd_level()) {
+  detail::check_arithmetic<Container>();
+  const auto position = detail::find_position<true>(c, threshold, std::min(level, detected_simd_level()));
+  return c.begin() + static_cast<typename Container::difference_type>(position);
+}
+} // namespace simd
+}
+
+#endif // CIRCULARALGORITHMS_H_
@@ -5,18 +5,404 @@
 #ifndef CIRCULARCONTAINER_H_
 #define CIRCULARCONTAINER_H_
 
-#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <initializer_list>
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+// Under C++20 (std::construct_at and friends are constexpr) the containers can
+// be built, filled and iterated in constant expressions.
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define VFC_CONSTEXPR20 constexpr
+#else
+#define VFC_CONSTEXPR20
+#endif
 
 namespace vfc {
+namespace detail {
+// Size of a cache line, used to keep independently written indices apart.
+inline constexpr std::size_t cache_line_size = 64;
+
+// Smallest unsigned type that can hold every value in [0, _max].
+template<std::size_t _max>
+using uint_for_t = std::conditional_t<
+  _max <= 0xFF, std::uint8_t,
+  std::conditional_t<_max <= 0xFFFF, std::uint16_t, std::conditional_t<_max <= 0xFFFFFFFF, std::uint32_t, std::uint64_t>>>;
+
+// Index arithmetic shared by the ring containers. A power-of-two capacity uses
+// exactly _capacity slots with free-running head/tail counters that are masked
+// on access; any other capacity keeps one spare slot so that a full ring has
+// head != tail. Either way the number of elements is distance(head, tail).
+//
+// Index is the type the counters are stored in: free-running counters wrap
+// modulo its range, which the power-of-two results below reproduce, so it must
+// hold _capacity (the largest distance).
+template<std::size_t _capacity, typename Index = std::size_t>
+struct ring_layout {
+  static constexpr bool is_power_of_two = _capacity != 0 && (_capacity & (_capacity - 1)) == 0;
+  static constexpr std::size_t buffer_size = is_power_of_two ? _capacity : _capacity + 1;
+
+  [[nodiscard]] static constexpr std::size_t slot(std::size_t index) noexcept {
+    if constexpr (is_power_of_two) {
+      return index & (buffer_size - 1);
+    } else {
+      return index;
+    }
+  }
+
+  [[nodiscard]] static constexpr std::size_t next_index(std::size_t index) noexcept {
+    if constexpr (is_power_of_two) {
+      return static_cast<Index>(index + 1);
+    } else {
+      return index + 1 == buffer_size ? 0 : index + 1;
+    }
+  }
+
+  [[nodiscard]] static constexpr std::size_t prev_index(std::size_t index) noexcept {
+    if constexpr (is_power_of_two) {
+      return static_cast<Index>(index - 1);
+    } else {
+      return index == 0 ? buffer_size - 1 : index - 1;
+    }
+  }
+
+  // Index reached by stepping count (<= buffer_size) slots forward.
+  [[nodiscard]] static constexpr std::size_t advance(std::size_t index, std::size_t count) noexcept {
+    if constexpr (is_power_of_two) {
+      return static_cast<Index>(index + count);
+    } else {
+      return index + count >= buffer_size ? index + count - buffer_size : index + count;
+    }
+  }
+
+  // Index reached by stepping count (<= buffer_size) slots backward.
+  [[nodiscard]] static constexpr std::size_t retreat(std::size_t index, std::size_t count) noexcept {
+    if constexpr (is_power_of_two) {
+      return static_cast<Index>(index - count);
+    } else {
+      return index >= count ? index - count : index + buffer_size - count;
+    }
+  }
+
+  // Number of elements in [head, tail).
+  [[nodiscard]] static constexpr std::size_t distance(std::size_t head, std::size_t tail) noexcept {
+    if constexpr (is_power_of_two) {
+      return static_cast<Index>(tail - head);
+    } else {
+      return tail >= head ? tail - head : tail + buffer_size - head;
+    }
+  }
+};
+
+// Raw storage for _size objects whose lifetimes are managed by the owning
+// container: nothing is constructed up front, elements are placement-new'ed
+// into slots and destroyed explicitly. The empty member is the active one
+// until then, which keeps a fresh array a constant so that static instances
+// are constant-initialized.
+template<typename Tp, std::size_t _size, bool = std::is_trivially_destructible_v<Tp>>
+union uninitialized_array {
+  struct inactive {};
+
+  VFC_CONSTEXPR20 uninitialized_array() noexcept : none() {}
+
+  inactive none;
+  Tp slots[_size];
+};
+
+template<typename Tp, std::size_t _size>
+union uninitialized_array<Tp, _size, false> {
+  struct inactive {};
+
+  VFC_CONSTEXPR20 uninitialized_array() noexcept : none() {}
+  VFC_CONSTEXPR20 ~uninitialized_array() {}
+
+  inactive none;
+  Tp slots[_size];
+};
+
+// Storage policy of CircularContainer: _capacity elements (plus a spare slot
+// unless _capacity is a power of two) inside the container object, placed as
+// Layout says. The index arithmetic is static so the ring logic compiles down
+// to constants.
+template<typename Tp, std::size_t _capacity, typename Layout>
+class fixed_ring_storage {
+  public:
+    // head/tail are stored in the smallest type that holds _capacity.
+    using index_type = uint_for_t<_capacity>;
+    using layout_policy = Layout;
+
+  private:
+    using layout = ring_layout<_capacity, index_type>;
+
+  public:
+    static constexpr bool is_power_of_two = layout::is_power_of_two;
+    static constexpr bool owns_heap_buffer = false;
+    static constexpr bool always_adopts = false;
+
+    VFC_CONSTEXPR20 fixed_ring_storage() noexcept {}
+    // Copies start out empty; the container copies the elements.
+    VFC_CONSTEXPR20 fixed_ring_storage(const fixed_ring_storage&) noexcept {}
+    fixed_ring_storage& operator=(const fixed_ring_storage&) = delete;
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept { return _capacity; }
+    [[nodiscard]] static constexpr std::size_t buffer_size() noexcept { return layout::buffer_size; }
+    [[nodiscard]] static constexpr std::size_t slot(std::size_t index) noexcept { return layout::slot(index); }
+    [[nodiscard]] static constexpr std::size_t next_index(std::size_t index) noexcept {
+      return layout::next_index(index);
+    }
+    [[nodiscard]] static constexpr std::size_t prev_index(std::size_t index) noexcept {
+      return layout::prev_index(index);
+    }
+    [[nodiscard]] static constexpr std::size_t advance(std::size_t index, std::size_t count) noexcept {
+      return layout::advance(index, count);
+    }
+    [[nodiscard]] static constexpr std::size_t retreat(std::size_t index, std::size_t count) noexcept {
+      return layout::retreat(index, count);
+    }
+    [[nodiscard]] static constexpr std::size_t distance(std::size_t head, std::size_t tail) noexcept {
+      return layout::distance(head, tail);
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 Tp* slots() noexcept { return m_buffer.slots; }
+    [[nodiscard]] VFC_CONSTEXPR20 const Tp* slots() const noexcept { return m_buffer.slots; }
+
+    template<typename... Args>
+    static VFC_CONSTEXPR20 void construct(Tp* target, Args&&... args) {
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+      std::construct_at(target, std::forward<Args>(args)...);
+#else
+      ::new (static_cast<void*>(target)) Tp(std::forward<Args>(args)...);
+#endif
+    }
+
+    static VFC_CONSTEXPR20 void destroy(Tp* target) noexcept {
+      if constexpr (!std::is_trivially_destructible_v<Tp>) {
+        target->~Tp();
+      }
+    }
+
+    template<typename ForwardIt>
+    static VFC_CONSTEXPR20 Tp* uninitialized_copy(ForwardIt first, ForwardIt last, Tp* out) {
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+      if (std::is_constant_evaluated()) {
+        // std::uninitialized_copy is not constexpr.
+        for (; first != last; ++first, ++out) {
+          construct(out, *first);
+        }
+        return out;
+      }
+#endif
+      return std::uninitialized_copy(first, last, out);
+    }
+
+  private:
+    alignas(Tp) alignas(Layout::buffer_alignment) uninitialized_array<Tp, layout::buffer_size> m_buffer;
+};
+
+template<typename It>
+using iterator_category_t = typename std::iterator_traits<It>::iterator_category;
+} // namespace detail
+
+// What push_front/emplace_front do when the container is full:
+enum class front_overflow {
+  overwrite_newest, // drop the back element to make room (a bounded deque)
+  overwrite_oldest  // replace front(), keeping the newest elements as push_back does
+};
+
+// Overflow policies: what push_back/emplace_back do when the container is full.
+// Drop front() to make room (the default).
+struct overwrite_oldest {};
+
+// Leave the container unchanged; push_back/emplace_back return false.
+struct reject_when_full {};
+
+// Drop front() after moving it into callback(value_type&&), e.g. to spill it
+// to disk or recycle its buffers. Every element a full ring drops goes through
+// the callback, also the back ones that push_front, insert and emplace drop.
+template<typename Callback>
+struct evict_to {
+  Callback callback;
+};
+
+template<typename Callback>
+evict_to(Callback) -> evict_to<Callback>;
+
+// Layout policies: where CircularContainer puts its buffer and bookkeeping.
+// An alignment of 1 keeps the natural one.
+// Smallest object: the bookkeeping is packed right after the elements (the
+// default).
+struct compact_layout {
+  static constexpr std::size_t buffer_alignment = 1;
+  static constexpr std::size_t index_alignment = 1;
+};
+
+// For containers kept side by side (e.g. in a vector) and updated from
+// different threads: the buffer starts on a cache line, which also suits
+// vector loads, and the object is a whole number of lines, so neighbouring
+// containers never share one. Within a container only the indices are split
+// (head on one line, tail and size on the next): pop_front and push_back both
+// write the size, so a single container is no cheaper to share between a
+// producer and a consumer thread (use SpscCircularContainer for that).
+struct cache_aligned_layout {
+  static constexpr std::size_t buffer_alignment = detail::cache_line_size;
+  static constexpr std::size_t index_alignment = detail::cache_line_size;
+};
+
+// Stats policies: which counters a container keeps about its own use, read
+// back with stats(). no_stats (the default) keeps none and costs nothing.
+struct container_stats {
+  std::uint64_t pushes = 0;     // elements added
+  std::uint64_t pops = 0;       // elements removed by pop_front/pop_back/read_into/erase
+  std::uint64_t overwrites = 0; // elements dropped to make room for new ones
+  std::uint64_t rejected = 0;   // elements not added because the container was full
+  std::uint64_t shifted = 0;    // elements moved by insert/erase to open or close a gap
+  std::size_t max_shift = 0;    // most elements moved by a single insert/erase
+  std::size_t peak_size = 0;    // largest size() after an addition
+};
+
+struct no_stats {
+  static constexpr bool enabled = false;
+};
+
+namespace detail {
+// Counters behind count_stats and atomic_stats. The atomic flavour uses
+// relaxed read-modify-writes, so the concurrent rings can update it from
+// several threads and stats() can be read from any thread; the counters are
+// then only individually, not mutually, consistent.
+template<bool _atomic>
+class stats_recorder {
+  public:
+    static constexpr bool enabled = true;
+
+    VFC_CONSTEXPR20 stats_recorder() noexcept {}
+    // Copies start from the source's counters.
+    VFC_CONSTEXPR20 stats_recorder(const stats_recorder& other) noexcept {
+      assign(other.snapshot());
+    }
+    VFC_CONSTEXPR20 stats_recorder& operator=(const stats_recorder& other) noexcept {
+      assign(other.snapshot());
+      return *this;
+    }
+
+    // size is the container's size() after adding count elements.
+    VFC_CONSTEXPR20 void on_push(std::size_t count, std::size_t size) noexcept {
+      add(m_pushes, count);
+      raise(m_peak_size, size);
+    }
+    VFC_CONSTEXPR20 void on_pop(std::size_t count) noexcept { add(m_pops, count); }
+    VFC_CONSTEXPR20 void on_overwrite(std::size_t count) noexcept { add(m_overwrites, count); }
+    VFC_CONSTEXPR20 void on_reject(std::size_t count) noexcept { add(m_rejected, count); }
+    VFC_CONSTEXPR20 void on_shift(std::size_t count) noexcept {
+      add(m_shifted, count);
+      raise(m_max_shift, count);
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 container_stats snapshot() const noexcept {
+      container_stats stats;
+      stats.pushes = read(m_pushes);
+      stats.pops = read(m_pops);
+      stats.overwrites = read(m_overwrites);
+      stats.rejected = read(m_rejected);
+      stats.shifted = read(m_shifted);
+      stats.max_shift = static_cast<std::size_t>(read(m_max_shift));
+      stats.peak_size = static_cast<std::size_t>(read(m_peak_size));
+      return stats;
+    }
+
+    VFC_CONSTEXPR20 void reset() noexcept {
+      assign(container_stats{});
+    }
+
+  private:
+    using counter = std::conditional_t<_atomic, std::atomic<std::uint64_t>, std::uint64_t>;
+
+    static VFC_CONSTEXPR20 void add(counter& target, std::uint64_t count) noexcept {
+      if constexpr (_atomic) {
+        target.fetch_add(count, std::memory_order_relaxed);
+      } else {
+        target += count;
+      }
+    }
+
+    static VFC_CONSTEXPR20 void raise(counter& target, std::uint64_t value) noexcept {
+      if constexpr (_atomic) {
+        std::uint64_t current = target.load(std::memory_order_relaxed);
+        while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+      } else if (target < value) {
+        target = value;
+      }
+    }
+
+    static VFC_CONSTEXPR20 std::uint64_t read(const counter& source) noexcept {
+      if constexpr (_atomic) {
+        return source.load(std::memory_order_relaxed);
+      } else {
+        return source;
+      }
+    }
+
+    static VFC_CONSTEXPR20 void write(counter& target, std::uint64_t value) noexcept {
+      if constexpr (_atomic) {
+        target.store(value, std::memory_order_relaxed);
+      } else {
+        target = value;
+      }
+    }
+
+    VFC_CONSTEXPR20 void assign(const container_stats& stats) noexcept {
+      write(m_pushes, stats.pushes);
+      write(m_pops, stats.pops);
+      write(m_overwrites, stats.overwrites);
+      write(m_rejected, stats.rejected);
+      write(m_shifted, stats.shifted);
+      write(m_max_shift, stats.max_shift);
+      write(m_peak_size, stats.peak_size);
+    }
+
+    counter m_pushes{0};
+    counter m_pops{0};
+    counter m_overwrites{0};
+    counter m_rejected{0};
+    counter m_shifted{0};
+    counter m_max_shift{0};
+    counter m_peak_size{0};
+};
+} // namespace detail
+
+// Plain counters, for a container used from one thread at a time.
+using count_stats = detail::stats_recorder<false>;
+
+// Relaxed atomic counters, for the concurrent rings or for reading stats()
+// from another thread than the one updating the container.
+using atomic_stats = detail::stats_recorder<true>;
+
+namespace detail {
+template<typename Overflow>
+inline constexpr bool is_evict_policy_v = false;
+
+template<typename Callback>
+inline constexpr bool is_evict_policy_v<evict_to<Callback>> = true;
+} // namespace detail
+
 // Forward declaration:
-template<typename Tp, std::size_t _capacity, bool _const>
+template<typename Tp, bool _const>
 class circular_container_reverse_iterator;
 
 // Iterate over elements in read/write mode //
-template<typename Tp, std::size_t _capacity, bool _const>
+template<typename Tp, bool _const>
 class circular_container_iterator {
   public:
     // Standard type definitions
@@ -27,140 +413,137 @@ class circular_container_iterator {
     using reference = std::conditional_t<_const, const value_type&, value_type&>;
     using const_reference = const value_type&;
     using difference_type = std::ptrdiff_t;
-    using iterator_category = std::bidirectional_iterator_tag;
-    using self_type = circular_container_iterator<Tp, _capacity, _const>;
-
-    // Constructor:
-    circular_container_iterator()
-      : m_container(nullptr), m_index(0) {
-    }
-
-    circular_container_iterator(const self_type& other)
-      : m_container(other.m_container), m_index(other.m_index) {
-    }
+    using iterator_category = std::random_access_iterator_tag;
+    using self_type = circular_container_iterator<Tp, _const>;
 
-    circular_container_iterator(self_type&& other) noexcept
-      : m_container(other.m_container), m_index(other.m_index) {
-      other.m_container = nullptr;
-      other.m_index = 0;
-    }
+    // Constructor (copy, move and destruction are trivial so iterators stay
+    // two words and are passed in registers):
+    circular_container_iterator() = default;
 
     // Constructor for non-const container
-    explicit circular_container_iterator(Tp& container, size_type index)
+    VFC_CONSTEXPR20 explicit circular_container_iterator(Tp& container, size_type index)
       : m_container(&container), m_index(index) {
     }
 
     // Constructor for const container
-    explicit circular_container_iterator(const Tp& container, size_type index)
+    VFC_CONSTEXPR20 explicit circular_container_iterator(const Tp& container, size_type index)
       : m_container(const_cast<Tp*>(&container)), m_index(index) {
     }
 
-    explicit circular_container_iterator(circular_container_reverse_iterator<Tp, _capacity, _const>& iter)
+    VFC_CONSTEXPR20 explicit circular_container_iterator(circular_container_reverse_iterator<Tp, _const>& iter)
       : m_container(iter.data()), m_index(iter.index()) {
     }
 
-    explicit circular_container_iterator(const circular_container_reverse_iterator<Tp, _capacity, _const>& iter)
+    VFC_CONSTEXPR20 explicit circular_container_iterator(const circular_container_reverse_iterator<Tp, _const>& iter)
       : m_container(iter.data()), m_index(iter.index()) {
     }
 
-    self_type& operator=(const self_type& other) {
-      if (this != &other) {
-        m_container = other.m_container;
-        m_index = other.m_index;
-      }
-      return *this;
+    // Operator overload:
+    [[nodiscard]] VFC_CONSTEXPR20 reference operator*() const {
+      return *m_container->slot_ptr(m_index);
     }
 
-    self_type& operator=(self_type&& other) noexcept {
-      if (this != &other) {
-        m_container = other.m_container;
-        m_index = other.m_index;
-        other.m_container = nullptr;
-        other.m_index = 0;
-      }
-      return *this;
+    [[nodiscard]] VFC_CONSTEXPR20 pointer operator->() const {
+      return m_container->slot_ptr(m_index);
     }
 
-    ~circular_container_iterator() {
-      m_container = nullptr;
-      m_capacity = 0;
-      m_index = 0;
+    VFC_CONSTEXPR20 self_type& operator++() {
+      m_index = m_container->next_index(m_index);
+      return *this;
     }
 
-    // Operator overload:
-    template<bool C = _const, typename std::enable_if<(!C), int>::type * = nullptr>
-    [[nodiscard]] reference operator*() {
-      return m_container->m_buffer[m_index];
-    }
-    template<bool C = _const, typename std::enable_if<(C), int>::type * = nullptr>
-    [[nodiscard]] const_reference operator*() const {
-      return m_container->m_buffer[m_index];
+    VFC_CONSTEXPR20 self_type operator++(int) {
+      auto temp_iterator = *this;
+      m_index = m_container->next_index(m_index);
+      return temp_iterator;
     }
 
-    template<bool C = _const, typename std::enable_if<(!C), int>::type * = nullptr>
-    [[nodiscard]] pointer operator->() {
-      return &(m_container->m_buffer[m_index]);
+    VFC_CONSTEXPR20 self_type& operator--() {
+      m_index = m_container->prev_index(m_index);
+      return *this;
     }
 
-    template<bool C = _const, typename std::enable_if<(C), int>::type * = nullptr>
-    [[nodiscard]] const_pointer operator->() const {
-      return &(m_container->m_buffer[m_index]);
+    VFC_CONSTEXPR20 self_type operator--(int) {
+      auto temp_iterator = *this;
+      m_index = m_container->prev_index(m_index);
+      return temp_iterator;
     }
 
-    self_type& operator++() {
-      ++m_index %= m_capacity;
+    VFC_CONSTEXPR20 self_type& operator+=(difference_type n) {
+      m_index = m_container->index_at(m_container->offset_of(m_index) + n);
       return *this;
     }
 
-    self_type operator++(int) {
+    VFC_CONSTEXPR20 self_type& operator-=(difference_type n) {
+      return *this += -n;
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 self_type operator+(difference_type n) const {
       auto temp_iterator = *this;
-      ++m_index %= m_capacity;
-      return temp_iterator;
+      return temp_iterator += n;
     }
 
-    self_type& operator--() {
-      if (m_index == 0) {
-        m_index = m_capacity - 1;
-      } else {
-        --m_index;
-      }
-      return *this;
+    [[nodiscard]] friend VFC_CONSTEXPR20 self_type operator+(difference_type n, const self_type& iter) {
+      return iter + n;
     }
 
-    self_type operator--(int) {
+    [[nodiscard]] VFC_CONSTEXPR20 self_type operator-(difference_type n) const {
       auto temp_iterator = *this;
-      if (m_index == 0) {
-        m_index = m_capacity - 1;
-      } else {
-        --m_index;
-      }
-      return temp_iterator;
+      return temp_iterator -= n;
     }
 
-    bool operator==(const self_type& other) const {
+    [[nodiscard]] VFC_CONSTEXPR20 difference_type operator-(const self_type& other) const {
+      return position() - other.position();
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 reference operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    VFC_CONSTEXPR20 bool operator==(const self_type& other) const {
       return m_index == other.m_index && m_container == other.m_container;
     }
 
-    bool operator!=(const self_type& other) const {
+    VFC_CONSTEXPR20 bool operator!=(const self_type& other) const {
       return !(*this == other);
     }
 
-    [[nodiscard]] size_type index() const noexcept {
+    VFC_CONSTEXPR20 bool operator<(const self_type& other) const {
+      return position() < other.position();
+    }
+
+    VFC_CONSTEXPR20 bool operator>(const self_type& other) const {
+      return other < *this;
+    }
+
+    VFC_CONSTEXPR20 bool operator<=(const self_type& other) const {
+      return !(other < *this);
+    }
+
+    VFC_CONSTEXPR20 bool operator>=(const self_type& other) const {
+      return !(*this < other);
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 size_type index() const noexcept {
       return m_index;
     }
 
-    [[nodiscard]] Tp* data() const noexcept {
+    [[nodiscard]] VFC_CONSTEXPR20 Tp* data() const noexcept {
       return m_container;
     }
 
   private:
-    Tp* m_container;
-    size_type m_capacity = _capacity + 1;
-    size_type m_index;
+    // Distance from begin(), which orders iterators and gives their difference.
+    [[nodiscard]] VFC_CONSTEXPR20 difference_type position() const noexcept {
+      return m_container->offset_of(m_index);
+    }
+
+    Tp* m_container = nullptr;
+    size_type m_index = 0;
 };
 
 // Iterate over elements in read-only mode //
-template<typename Tp, std::size_t _capacity, bool _const>
+template<typename Tp, bool _const>
 class circular_container_reverse_iterator {
   public:
     // Standard type definitions
@@ -171,141 +554,143 @@ class circular_container_reverse_iterator {
     using reference = std::conditional_t<_const, const value_type&, value_type&>;
     using const_reference = const value_type&;
     using difference_type = std::ptrdiff_t;
-    using iterator_category = std::bidirectional_iterator_tag;
-    using self_type = circular_container_reverse_iterator<Tp, _capacity, _const>;
+    using iterator_category = std::random_access_iterator_tag;
+    using self_type = circular_container_reverse_iterator<Tp, _const>;
 
-    // Constructor:
-    circular_container_reverse_iterator()
-      : m_container(nullptr), m_index(0) {
-    }
-
-    circular_container_reverse_iterator(const self_type& other)
-      : m_container(other.m_container), m_index(other.m_index) {
-    }
-
-    circular_container_reverse_iterator(self_type&& other) noexcept
-      : m_container(other.m_container), m_index(other.m_index) {
-      other.m_container = nullptr;
-      other.m_index = 0;
-    }
+    // Constructor (copy, move and destruction are trivial so iterators stay
+    // two words and are passed in registers):
+    circular_container_reverse_iterator() = default;
 
     // Constructor for non-const container
-    explicit circular_container_reverse_iterator(Tp& container, size_type index)
+    VFC_CONSTEXPR20 explicit circular_container_reverse_iterator(Tp& container, size_type index)
       : m_container(&container), m_index(index) {
     }
 
     // Constructor for const container
-    explicit circular_container_reverse_iterator(const Tp& container, size_type index)
+    VFC_CONSTEXPR20 explicit circular_container_reverse_iterator(const Tp& container, size_type index)
       : m_container(const_cast<Tp*>(&container)), m_index(index) {
     }
 
-    explicit circular_container_reverse_iterator(circular_container_iterator<Tp, _capacity, _const>& iter)
+    VFC_CONSTEXPR20 explicit circular_container_reverse_iterator(circular_container_iterator<Tp, _const>& iter)
       : m_container(iter.data()), m_index(iter.index()) {
     }
 
-    explicit circular_container_reverse_iterator(const circular_container_iterator<Tp, _capacity, _const>& iter)
+    VFC_CONSTEXPR20 explicit circular_container_reverse_iterator(const circular_container_iterator<Tp, _const>& iter)
       : m_container(iter.data()), m_index(iter.index()) {
     }
 
-    self_type& operator=(const self_type& other) {
-      if (this != &other) {
-        m_container = other.m_container;
-        m_index = other.m_index;
-      }
-      return *this;
+    // Operator overload:
+    [[nodiscard]] VFC_CONSTEXPR20 reference operator*() const {
+      return *m_container->slot_ptr(m_index);
     }
 
-    self_type& operator=(self_type&& other) noexcept {
-      if (this != &other) {
-        m_container = other.m_container;
-        m_index = other.m_index;
-        other.m_container = nullptr;
-        other.m_index = 0;
-      }
-      return *this;
+    [[nodiscard]] VFC_CONSTEXPR20 pointer operator->() const {
+      return m_container->slot_ptr(m_index);
     }
 
-    ~circular_container_reverse_iterator() {
-      m_container = nullptr;
-      m_capacity = 0;
-      m_index = 0;
+    VFC_CONSTEXPR20 self_type& operator++() {
+      m_index = m_container->prev_index(m_index);
+      return *this;
     }
 
-    // Operator overload:
-    template<bool C = _const, typename std::enable_if<(!C), int>::type * = nullptr>
-    [[nodiscard]] reference operator*() {
-      return m_container->m_buffer[m_index];
-    }
-    template<bool C = _const, typename std::enable_if<(C), int>::type * = nullptr>
-    [[nodiscard]] const_reference operator*() const {
-      return m_container->m_buffer[m_index];
+    VFC_CONSTEXPR20 self_type operator++(int) {
+      auto temp_iterator = *this;
+      m_index = m_container->prev_index(m_index);
+      return temp_iterator;
     }
 
-    template<bool C = _const, typename std::enable_if<(!C), int>::type * = nullptr>
-    [[nodiscard]] pointer operator->() {
-      return &(m_container->m_buffer[m_index]);
+    VFC_CONSTEXPR20 self_type& operator--() {
+      m_index = m_container->next_index(m_index);
+      return *this;
     }
 
-    template<bool C = _const, typename std::enable_if<(C), int>::type * = nullptr>
-    [[nodiscard]] const_pointer operator->() const {
-      return &(m_container->m_buffer[m_index]);
+    VFC_CONSTEXPR20 self_type operator--(int) {
+      auto temp_iterator = *this;
+      m_index = m_container->next_index(m_index);
+      return temp_iterator;
     }
 
-    self_type& operator++() {
-      if (m_index == 0) {
-        m_index = m_capacity - 1;
-      } else {
-        --m_index;
-      }
+    VFC_CONSTEXPR20 self_type& operator+=(difference_type n) {
+      m_index = m_container->index_at(m_container->reverse_offset_of(m_index) - n);
       return *this;
     }
 
-    self_type operator++(int) {
+    VFC_CONSTEXPR20 self_type& operator-=(difference_type n) {
+      return *this += -n;
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 self_type operator+(difference_type n) const {
       auto temp_iterator = *this;
-      if (m_index == 0) {
-        m_index = m_capacity - 1;
-      } else {
-        --m_index;
-      }
-      return temp_iterator;
+      return temp_iterator += n;
     }
 
-    self_type& operator--() {
-      ++m_index %= m_capacity;
-      return *this;
+    [[nodiscard]] friend VFC_CONSTEXPR20 self_type operator+(difference_type n, const self_type& iter) {
+      return iter + n;
     }
 
-    self_type operator--(int) {
+    [[nodiscard]] VFC_CONSTEXPR20 self_type operator-(difference_type n) const {
       auto temp_iterator = *this;
-      ++m_index %= m_capacity;
-      return temp_iterator;
+      return temp_iterator -= n;
     }
 
-    bool operator==(const self_type& other) const {
+    [[nodiscard]] VFC_CONSTEXPR20 difference_type operator-(const self_type& other) const {
+      return position() - other.position();
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 reference operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    VFC_CONSTEXPR20 bool operator==(const self_type& other) const {
       return m_index == other.m_index && m_container == other.m_container;
     }
 
-    bool operator!=(const self_type& other) const {
+    VFC_CONSTEXPR20 bool operator!=(const self_type& other) const {
       return !(*this == other);
     }
 
-    [[nodiscard]] size_type index() const noexcept {
+    VFC_CONSTEXPR20 bool operator<(const self_type& other) const {
+      return position() < other.position();
+    }
+
+    VFC_CONSTEXPR20 bool operator>(const self_type& other) const {
+      return other < *this;
+    }
+
+    VFC_CONSTEXPR20 bool operator<=(const self_type& other) const {
+      return !(other < *this);
+    }
+
+    VFC_CONSTEXPR20 bool operator>=(const self_type& other) const {
+      return !(*this < other);
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 size_type index() const noexcept {
       return m_index;
     }
 
-    [[nodiscard]] Tp* data() const noexcept {
+    [[nodiscard]] VFC_CONSTEXPR20 Tp* data() const noexcept {
       return m_container;
     }
 
   private:
-    Tp* m_container;
-    size_type m_capacity = _capacity + 1;
-    size_type m_index;
+    // Distance from rbegin(), which orders iterators and gives their difference.
+    [[nodiscard]] VFC_CONSTEXPR20 difference_type position() const noexcept {
+      return -m_container->reverse_offset_of(m_index);
+    }
+
+    Tp* m_container = nullptr;
+    size_type m_index = 0;
 };
 
-// Circular Container class implementation: ///
-template<typename Tp, std::size_t _capacity>
-class CircularContainer {
+namespace detail {
+// Ring logic shared by CircularContainer and DynamicCircularContainer. Storage
+// owns the slots and provides the index arithmetic (see fixed_ring_storage);
+// this class manages the element lifetimes and the head/tail indices. The
+// overflow and stats policies are private bases so that stateless policies
+// take no space.
+template<typename Tp, typename Storage, typename Overflow = overwrite_oldest, typename Stats = no_stats>
+class circular_container_base : private Overflow, private Stats {
   public:
     // Standard type definitions used also in STL containers:
     using value_type = Tp;
@@ -315,88 +700,384 @@ class CircularContainer {
     using const_pointer = const value_type*;
     using reference = value_type&;
     using const_reference = const value_type&;
-    using iterator = circular_container_iterator<CircularContainer<Tp, _capacity>, _capacity, false>;
-    using const_iterator = circular_container_iterator<CircularContainer<Tp, _capacity>, _capacity, true>;
-    using reverse_iterator = circular_container_reverse_iterator<CircularContainer<Tp, _capacity>, _capacity, false>;
-    using const_reverse_iterator = circular_container_reverse_iterator<
-      CircularContainer<Tp, _capacity>, _capacity, true>;
-
-    CircularContainer() = default;
-    CircularContainer(const CircularContainer& other) = default;
-    CircularContainer(CircularContainer&& other) = default;
-    CircularContainer& operator=(const CircularContainer& other) = default;
-    CircularContainer& operator=(CircularContainer&& other) = default;
-    ~CircularContainer() = default;
+    using iterator = circular_container_iterator<circular_container_base, false>;
+    using const_iterator = circular_container_iterator<circular_container_base, true>;
+    using reverse_iterator = circular_container_reverse_iterator<circular_container_base, false>;
+    using const_reverse_iterator = circular_container_reverse_iterator<circular_container_base, true>;
+    using array_range = std::pair<pointer, size_type>;
+    using const_array_range = std::pair<const_pointer, size_type>;
+    using overflow_policy_type = Overflow;
+    using stats_policy_type = Stats;
+
+    // Construction is O(1): slots are only constructed as elements are added.
+    // (User-provided so that value-initialization does not zero the buffer.)
+    VFC_CONSTEXPR20 circular_container_base() noexcept {}
+
+    template<typename... StorageArgs>
+    VFC_CONSTEXPR20 explicit circular_container_base(std::in_place_t, const Overflow& policy, StorageArgs&&... args)
+      : Overflow(policy), m_storage(std::forward<StorageArgs>(args)...) {
+    }
 
-    // Enable CircularContainer class to be brace initialized:
-    explicit CircularContainer(std::initializer_list<value_type> values) {
-      for (auto& item : values) {
-        this->insert(this->end(), item);
+    VFC_CONSTEXPR20 circular_container_base(const circular_container_base& other)
+      : Overflow(other), Stats(other), m_storage(other.m_storage) {
+      construct_from(other);
+    }
+
+    // A heap buffer is handed over in O(1); inline storage moves element-wise.
+    VFC_CONSTEXPR20 circular_container_base(circular_container_base&& other) noexcept(nothrow_move)
+      : Overflow(std::move(other)), Stats(other), m_storage(std::move(other.m_storage)) {
+      if constexpr (Storage::owns_heap_buffer) {
+        take_indices(other);
+      } else {
+        construct_from(std::move(other));
+      }
+    }
+
+    VFC_CONSTEXPR20 circular_container_base& operator=(const circular_container_base& other) {
+      if (this != &other) {
+        clear();
+        Overflow::operator=(other);
+        Stats::operator=(other);
+        if constexpr (Storage::owns_heap_buffer) {
+          m_storage.assign_empty(other.m_storage);
+        }
+        construct_from(other);
+      }
+      return *this;
+    }
+
+    VFC_CONSTEXPR20 circular_container_base& operator=(circular_container_base&& other) noexcept(nothrow_move_assign) {
+      if (this != &other) {
+        clear();
+        Overflow::operator=(std::move(other));
+        Stats::operator=(other);
+        if constexpr (Storage::owns_heap_buffer) {
+          if (m_storage.adopt(std::move(other.m_storage))) {
+            take_indices(other);
+            return *this;
+          }
+        }
+        construct_from(std::move(other));
+      }
+      return *this;
+    }
+
+    // Exchanges the contents (and policies). Heap buffers are exchanged in
+    // O(1) when the allocators allow it, otherwise their elements are moved.
+    // Inline storage swaps the elements both sides have in place and moves
+    // the rest of the longer side across, without a temporary container.
+    VFC_CONSTEXPR20 void swap(circular_container_base& other) noexcept(nothrow_swap) {
+      if (this == &other) {
+        return;
       }
+      if constexpr (Storage::owns_heap_buffer) {
+        circular_container_base temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+      } else {
+        swap_elements(other);
+        using std::swap;
+        swap(static_cast<Overflow&>(*this), static_cast<Overflow&>(other));
+        Stats stats(static_cast<const Stats&>(*this));
+        Stats::operator=(other);
+        static_cast<Stats&>(other) = stats;
+      }
+    }
+
+    friend VFC_CONSTEXPR20 void swap(circular_container_base& a, circular_container_base& b)
+      noexcept(noexcept(a.swap(b))) {
+      a.swap(b);
+    }
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 202002L
+    // Trivial when there is nothing to release, so that static instances need
+    // no registered destructor.
+    ~circular_container_base()
+      requires(std::is_trivially_destructible_v<Tp> && std::is_trivially_destructible_v<Storage> &&
+               std::is_trivially_destructible_v<Overflow> && std::is_trivially_destructible_v<Stats>)
+    = default;
+#endif
+
+    VFC_CONSTEXPR20 ~circular_container_base() {
+      clear();
     }
 
     // Modifiers
-    void push_back(const value_type& item) {
-      m_buffer[m_tail] = item;
-      ++m_tail %= m_capacity;
-      ++m_content_size;
-      if (m_tail == m_head) {
-        ++m_head %= m_capacity;
-        m_content_size = m_capacity - 1;
+    // What happens when full depends on the overflow policy; with
+    // reject_when_full these return whether the element was added, otherwise
+    // nothing.
+    VFC_CONSTEXPR20 auto push_back(const value_type& item) {
+      if constexpr (std::is_same_v<Overflow, reject_when_full>) {
+        return emplace_back(item);
+      } else if (!discard_without_room(item)) {
+        append(item);
       }
     }
-    void emplace_back(value_type&& item) {
-      m_buffer[m_tail] = std::move(item);
-      ++m_tail %= m_capacity;
-      ++m_content_size;
-      if (m_tail == m_head) {
-        ++m_head %= m_capacity;
-        m_content_size = m_capacity - 1;
+    VFC_CONSTEXPR20 auto push_back(value_type&& item) {
+      if constexpr (std::is_same_v<Overflow, reject_when_full>) {
+        return emplace_back(std::move(item));
+      } else if (!discard_without_room(std::move(item))) {
+        append(std::move(item));
+      }
+    }
+
+    // Constructs the new back element directly in its slot and returns it (or,
+    // with reject_when_full, whether it was added). If the container is full
+    // the oldest element is evicted first, so args must not refer to it.
+    // Without reject_when_full, a ring of capacity 0 has no element to return
+    // and throws std::out_of_range.
+    template<typename... Args>
+    VFC_CONSTEXPR20 decltype(auto) emplace_back(Args&&... args) {
+      if constexpr (std::is_same_v<Overflow, reject_when_full>) {
+        if (full()) {
+          record_reject(1);
+          return false;
+        }
+        append(std::forward<Args>(args)...);
+        return true;
+      } else {
+        check_room("CircularContainer::emplace_back() - capacity is 0");
+        return append(std::forward<Args>(args)...);
+      }
+    }
+
+    // Prepends an element in O(1). If full, Policy decides which element makes
+    // room: by default the back one (as with insert(begin(), ...)).
+    template<front_overflow Policy = front_overflow::overwrite_newest>
+    VFC_CONSTEXPR20 void push_front(const value_type& item) {
+      if (!discard_without_room(item)) {
+        emplace_front<Policy>(item);
+      }
+    }
+
+    template<front_overflow Policy = front_overflow::overwrite_newest>
+    VFC_CONSTEXPR20 void push_front(value_type&& item) {
+      if (!discard_without_room(std::move(item))) {
+        emplace_front<Policy>(std::move(item));
+      }
+    }
+
+    // Constructs a new front element in place and returns it; see push_front.
+    // Like emplace_back, throws std::out_of_range on a ring of capacity 0.
+    template<front_overflow Policy = front_overflow::overwrite_newest, typename... Args>
+    VFC_CONSTEXPR20 reference emplace_front(Args&&... args) {
+      check_room("CircularContainer::emplace_front() - capacity is 0");
+      if (full()) {
+        // Built before making room: args may refer to the element that goes.
+        value_type item(std::forward<Args>(args)...);
+        if constexpr (Policy == front_overflow::overwrite_newest) {
+          evict_back(1);
+          drop_back(1);
+        } else {
+          evict_front(1);
+          drop_front(1);
+        }
+        return construct_front(true, std::move(item));
       }
+      return construct_front(false, std::forward<Args>(args)...);
+    }
+
+    // Appends [first, last) as if by repeated push_back: if the range does not
+    // fit, the oldest elements are dropped, and only the last capacity()
+    // elements of a longer range are kept. Forward ranges are copied into at
+    // most two contiguous runs of the buffer. With reject_when_full only the
+    // leading elements that fit are appended and their number is returned;
+    // the rest of a forward range is counted as rejected, while an input
+    // range is not read past the first element that does not fit, which is
+    // the only one counted. With evict_to every element goes through
+    // push_back.
+    template<typename InputIt, typename = detail::iterator_category_t<InputIt>>
+    VFC_CONSTEXPR20 auto push_back(InputIt first, InputIt last) {
+      if constexpr (detail::is_evict_policy_v<Overflow>) {
+        for (; first != last; ++first) {
+          push_back(*first);
+        }
+      } else if constexpr (std::is_same_v<Overflow, reject_when_full>) {
+        size_type count = 0;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, detail::iterator_category_t<InputIt>>) {
+          const auto offered = static_cast<size_type>(std::distance(first, last));
+          count = std::min(offered, capacity() - m_content_size);
+          append_range(first, count);
+          record_push(count, 0);
+          record_reject(offered - count);
+        } else {
+          for (; first != last && push_back(*first); ++first) {
+            ++count;
+          }
+        }
+        return count;
+      } else if constexpr (std::is_base_of_v<std::forward_iterator_tag, detail::iterator_category_t<InputIt>>) {
+        auto count = static_cast<size_type>(std::distance(first, last));
+        const size_type room = capacity();
+        // Counted as the repeated push_back it stands for.
+        const size_type pushed = count;
+        const size_type dropped = m_content_size + count > room ? m_content_size + count - room : 0;
+        if (count >= room) {
+          std::advance(first, count - room);
+          count = room;
+          clear();
+        } else if (count > room - m_content_size) {
+          drop_front(count - (room - m_content_size));
+        }
+        append_range(first, count);
+        record_push(pushed, dropped);
+      } else {
+        for (; first != last; ++first) {
+          push_back(*first);
+        }
+      }
+    }
+
+#ifdef __cpp_lib_span
+    VFC_CONSTEXPR20 auto push_back(std::span<const value_type> items) {
+      return push_back(items.begin(), items.end());
     }
+#endif
 
-    void pop_front() {
+    VFC_CONSTEXPR20 void pop_front() {
       if (m_head != m_tail) {
-        ++m_head %= m_capacity;
-        --m_content_size;
+        drop_front(1);
+        record_pop(1);
       } else {
         clear();
       }
     }
 
-    void insert(iterator pos, const value_type& item) {
-      // inserts item before pos:
-      for (auto it = end(); it != pos; --it) {
-        m_buffer[it.index()] = m_buffer[std::prev(it).index()];
+    VFC_CONSTEXPR20 void pop_back() {
+      if (m_head != m_tail) {
+        drop_back(1);
+        record_pop(1);
+      } else {
+        clear();
       }
-      m_buffer[pos.index()] = item;
-      if (!full()) {
-        ++m_tail %= m_capacity;
-        ++m_content_size;
-        if (m_tail == m_head) {
-          ++m_head %= m_capacity;
-          m_content_size = m_capacity - 1;
-        }
+    }
+
+    // Removes the count newest elements (all of them if count >= size()).
+    VFC_CONSTEXPR20 void pop_back(size_type count) {
+      record_pop(std::min(count, size()));
+      if (count >= m_content_size) {
+        clear();
+      } else {
+        drop_back(count);
       }
     }
 
-    void insert(iterator pos, value_type&& item) {
-      // inserts item before pos:
-      for (auto it = end(); it != pos; --it) {
-        m_buffer[it.index()] = m_buffer[std::prev(it).index()];
+    // Removes the count oldest elements (all of them if count >= size()).
+    VFC_CONSTEXPR20 void pop_front(size_type count) {
+      record_pop(std::min(count, size()));
+      if (count >= m_content_size) {
+        clear();
+      } else {
+        drop_front(count);
       }
-      m_buffer[pos.index()] = std::move(item);
-      if (!full()) {
-        ++m_tail %= m_capacity;
-        ++m_content_size;
-        if (m_tail == m_head) {
-          ++m_head %= m_capacity;
-          m_content_size = m_capacity - 1;
+    }
+
+    // Moves up to count of the oldest elements to out and removes them from the
+    // container; returns the number of elements read.
+    template<typename OutputIt>
+    VFC_CONSTEXPR20 size_type read_into(OutputIt out, size_type count) {
+      count = std::min(count, size());
+      const size_type start = m_storage.slot(m_head);
+      const size_type first_part = std::min(count, m_storage.buffer_size() - start);
+      const pointer slots = m_storage.slots();
+      out = std::move(slots + start, slots + start + first_part, out);
+      std::move(slots, slots + (count - first_part), out);
+      pop_front(count);
+      return count;
+    }
+
+    // Inserts item before pos and returns an iterator to it. Whichever side of
+    // pos is shorter is shifted, one contiguous run at a time. When full, the
+    // last element is dropped instead, and inserting at end() does nothing
+    // (end() is returned).
+    VFC_CONSTEXPR20 iterator insert(iterator pos, const value_type& item) {
+      // Copied first: item may be one of the elements about to be shifted.
+      return insert_one(pos, value_type(item));
+    }
+
+    VFC_CONSTEXPR20 iterator insert(iterator pos, value_type&& item) {
+      return insert_one(pos, std::move(item));
+    }
+
+    // Inserts [first, last) before pos and returns an iterator to the first
+    // inserted element. Elements that would end up past capacity() are dropped,
+    // starting with the last ones of the container, as with insert().
+    template<typename InputIt, typename = detail::iterator_category_t<InputIt>>
+    VFC_CONSTEXPR20 iterator insert(iterator pos, InputIt first, InputIt last) {
+      if constexpr (std::is_base_of_v<std::forward_iterator_tag, detail::iterator_category_t<InputIt>>) {
+        const size_type offset = static_cast<size_type>(offset_of(pos.index()));
+        const size_type count = std::min(static_cast<size_type>(std::distance(first, last)), capacity() - offset);
+        if (count == 0) {
+          return pos;
+        }
+        const size_type kept = std::min(m_content_size - offset, capacity() - offset - count);
+        const size_type dropped = m_content_size - offset - kept;
+        evict_back(dropped);
+        drop_back(dropped);
+        const size_type index = open_gap(offset, count);
+        size_type filled = 0;
+        try {
+          for (size_type target = index; filled != count; ++filled, ++first, target = m_storage.next_index(target)) {
+            construct(slot_ptr(target), *first);
+          }
+        } catch (...) {
+          destroy(index, filled);
+          close_gap(offset, count);
+          throw;
+        }
+        record_push(count, dropped);
+        return iterator(*this, index);
+      } else {
+        const difference_type offset = offset_of(pos.index());
+        difference_type inserted = 0;
+        for (; first != last; ++first, ++inserted) {
+          if (insert(begin() + (offset + inserted), *first) == end()) {
+            break;
+          }
+        }
+        return begin() + offset;
+      }
+    }
+
+    // Inserts an element constructed from args before pos and returns an
+    // iterator to it (end() if nothing was inserted, see insert()). At end()
+    // the element is constructed in its slot; elsewhere it is constructed
+    // once and moved into the hole.
+    template<typename... Args>
+    VFC_CONSTEXPR20 iterator emplace(iterator pos, Args&&... args) {
+      if (pos == end()) {
+        if (full()) {
+          record_reject(1);
+          return end();
         }
+        construct(slot_ptr(m_tail), std::forward<Args>(args)...);
+        grow_back();
+        record_push(1, 0);
+        return pos;
       }
+      return insert_one(pos, value_type(std::forward<Args>(args)...));
+    }
+
+    // Removes the element at pos and returns an iterator to the one after it.
+    VFC_CONSTEXPR20 iterator erase(iterator pos) {
+      return erase(pos, std::next(pos));
     }
 
-    void clear() {
+    // Removes [first, last), closing the hole from whichever side is shorter,
+    // and returns an iterator to the element that followed last.
+    VFC_CONSTEXPR20 iterator erase(iterator first, iterator last) {
+      const size_type offset = static_cast<size_type>(offset_of(first.index()));
+      const size_type count = static_cast<size_type>(last - first);
+      if (count != 0) {
+        destroy(first.index(), count);
+        close_gap(offset, count);
+        record_pop(count);
+      }
+      return iterator(*this, index_at(static_cast<difference_type>(offset)));
+    }
+
+    VFC_CONSTEXPR20 void clear() {
+      destroy(m_head, m_content_size);
       m_content_size = 0;
       m_head = 0;
       m_tail = 0;
@@ -404,48 +1085,93 @@ class CircularContainer {
 
     // Capacity:
     [[nodiscard]] constexpr size_type capacity() const noexcept {
-      return m_capacity - 1;
+      return m_storage.capacity();
     }
 
     [[nodiscard]] constexpr bool empty() const noexcept {
       return !m_content_size;
     }
     [[nodiscard]] constexpr bool full() const noexcept {
-      return m_content_size == m_capacity - 1;
+      return m_content_size == capacity();
     }
 
     [[nodiscard]] constexpr size_type size() const noexcept {
       return m_content_size;
     }
 
+    // The overflow policy object, e.g. to reach the state of an evict_to callback.
+    [[nodiscard]] VFC_CONSTEXPR20 Overflow& overflow_policy() noexcept {
+      return *this;
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 const Overflow& overflow_policy() const noexcept {
+      return *this;
+    }
+
+    // Snapshot of the counters kept by the stats policy (count_stats or
+    // atomic_stats; does not compile with no_stats).
+    template<typename S = Stats>
+    [[nodiscard]] VFC_CONSTEXPR20 container_stats stats() const noexcept {
+      static_assert(S::enabled, "stats() needs a stats policy such as vfc::count_stats");
+      return static_cast<const Stats&>(*this).snapshot();
+    }
+
+    template<typename S = Stats>
+    VFC_CONSTEXPR20 void reset_stats() noexcept {
+      static_assert(S::enabled, "reset_stats() needs a stats policy such as vfc::count_stats");
+      static_cast<Stats&>(*this).reset();
+    }
+
     // Iterators:
-    iterator begin() { return iterator(*this, m_head); }
+    VFC_CONSTEXPR20 iterator begin() { return iterator(*this, m_head); }
 
-    iterator end() { return iterator(*this, m_tail); }
+    VFC_CONSTEXPR20 iterator end() { return iterator(*this, m_tail); }
 
-    const_iterator begin() const { return const_iterator(*this, m_head); }
+    VFC_CONSTEXPR20 const_iterator begin() const { return const_iterator(*this, m_head); }
 
-    const_iterator end() const { return const_iterator(*this, m_tail); }
+    VFC_CONSTEXPR20 const_iterator end() const { return const_iterator(*this, m_tail); }
 
-    const_iterator cbegin() const { return const_iterator(*this, m_head); }
+    VFC_CONSTEXPR20 const_iterator cbegin() const { return const_iterator(*this, m_head); }
 
-    const_iterator cend() const { return const_iterator(*this, m_tail); }
+    VFC_CONSTEXPR20 const_iterator cend() const { return const_iterator(*this, m_tail); }
 
     // reverse iterator
-    reverse_iterator rbegin() { return reverse_iterator(*this, (--end()).index()); }
+    VFC_CONSTEXPR20 reverse_iterator rbegin() { return reverse_iterator(*this, (--end()).index()); }
 
-    reverse_iterator rend() { return reverse_iterator(*this, (--begin()).index()); }
+    VFC_CONSTEXPR20 reverse_iterator rend() { return reverse_iterator(*this, (--begin()).index()); }
 
-    const_reverse_iterator rbegin() const { return const_reverse_iterator(*this, (--end()).index()); }
+    VFC_CONSTEXPR20 const_reverse_iterator rbegin() const { return const_reverse_iterator(*this, (--end()).index()); }
 
-    const_reverse_iterator rend() const { return const_reverse_iterator(*this, (--begin()).index()); }
+    VFC_CONSTEXPR20 const_reverse_iterator rend() const { return const_reverse_iterator(*this, (--begin()).index()); }
 
-    const_reverse_iterator crbegin() const { return const_reverse_iterator(*this, (--end()).index()); }
+    VFC_CONSTEXPR20 const_reverse_iterator crbegin() const { return const_reverse_iterator(*this, (--end()).index()); }
 
-    const_reverse_iterator crend() const { return const_reverse_iterator(*this, (--begin()).index()); }
+    VFC_CONSTEXPR20 const_reverse_iterator crend() const { return const_reverse_iterator(*this, (--begin()).index()); }
 
     // Element access:
-    reference front() {
+    VFC_CONSTEXPR20 reference operator[](size_type pos) {
+      return *slot_ptr(m_storage.advance(m_head, pos));
+    }
+
+    VFC_CONSTEXPR20 const_reference operator[](size_type pos) const {
+      return *slot_ptr(m_storage.advance(m_head, pos));
+    }
+
+    VFC_CONSTEXPR20 reference at(size_type pos) {
+      if (pos >= m_content_size) {
+        throw std::out_of_range("CircularContainer::at() - index out of range");
+      }
+      return (*this)[pos];
+    }
+
+    VFC_CONSTEXPR20 const_reference at(size_type pos) const {
+      if (pos >= m_content_size) {
+        throw std::out_of_range("CircularContainer::at() - index out of range");
+      }
+      return (*this)[pos];
+    }
+
+    VFC_CONSTEXPR20 reference front() {
       // Undefined Behavior if container is empty!
       if (empty()) { // Check if the container is empty
         throw std::out_of_range("CircularContainer::front() - container is empty");
@@ -453,7 +1179,7 @@ class CircularContainer {
       return *begin();
     }
 
-    reference back() {
+    VFC_CONSTEXPR20 reference back() {
       // Undefined Behavior if container is empty!
       if (empty()) { // Check if the container is empty
         throw std::out_of_range("CircularContainer::back() - container is empty");
@@ -461,7 +1187,7 @@ class CircularContainer {
       return *(--end());
     }
 
-    const_reference front() const {
+    VFC_CONSTEXPR20 const_reference front() const {
       // Undefined Behavior if container is empty!
       if (empty()) { // Check if the container is empty
         throw std::out_of_range("CircularContainer::front() - container is empty");
@@ -469,7 +1195,7 @@ class CircularContainer {
       return *begin();
     }
 
-    const_reference back() const {
+    VFC_CONSTEXPR20 const_reference back() const {
       // Undefined Behavior if container is empty!
       if (empty()) { // Check if the container is empty
         throw std::out_of_range("CircularContainer::back() - container is empty");
@@ -477,17 +1203,588 @@ class CircularContainer {
       return *(--end());
     }
 
+    // Contiguous storage access:
+    // The elements occupy at most two runs of the buffer: array_one() starts at
+    // front() and array_two() holds the wrapped remainder (empty if none).
+    VFC_CONSTEXPR20 array_range array_one() noexcept {
+      return {slot_ptr(m_head), first_run_size()};
+    }
+
+    VFC_CONSTEXPR20 array_range array_two() noexcept {
+      return {m_storage.slots(), m_content_size - first_run_size()};
+    }
+
+    VFC_CONSTEXPR20 const_array_range array_one() const noexcept {
+      return {slot_ptr(m_head), first_run_size()};
+    }
+
+    VFC_CONSTEXPR20 const_array_range array_two() const noexcept {
+      return {m_storage.slots(), m_content_size - first_run_size()};
+    }
+
+#ifdef __cpp_lib_span
+    [[nodiscard]] VFC_CONSTEXPR20 std::pair<std::span<value_type>, std::span<value_type>> segments() noexcept {
+      const auto one = array_one();
+      const auto two = array_two();
+      return {{one.first, one.second}, {two.first, two.second}};
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 std::pair<std::span<const value_type>, std::span<const value_type>> segments() const noexcept {
+      const auto one = array_one();
+      const auto two = array_two();
+      return {{one.first, one.second}, {two.first, two.second}};
+    }
+#endif
+
+    [[nodiscard]] VFC_CONSTEXPR20 bool is_linearized() const noexcept {
+      return first_run_size() == m_content_size;
+    }
+
+    // Rotates the buffer in place so that all elements form the single run
+    // [linearize(), linearize() + size()). Invalidates iterators.
+    VFC_CONSTEXPR20 pointer linearize() {
+      if (!is_linearized()) {
+        // Slide the first run down next to the wrapped one, through the free
+        // slots between them, then rotate the now contiguous elements.
+        const size_type first_part = first_run_size();
+        const size_type second_part = m_content_size - first_part;
+        const size_type start = m_storage.slot(m_head);
+        const pointer slots = m_storage.slots();
+        if (start != second_part) {
+          for (size_type i = 0; i < first_part; ++i) {
+            construct(slots + second_part + i, std::move(slots[start + i]));
+            m_storage.destroy(slots + start + i);
+          }
+        }
+        std::rotate(slots, slots + second_part, slots + m_content_size);
+        m_head = 0;
+        m_tail = m_content_size;
+      }
+      return slot_ptr(m_head);
+    }
+
+  protected:
+    using index_type = typename Storage::index_type;
+    using layout_policy = typename Storage::layout_policy;
+
+    static constexpr bool nothrow_move =
+      Storage::owns_heap_buffer || std::is_nothrow_move_constructible_v<value_type>;
+    // Move assignment can only take over a heap buffer whose allocator may be
+    // moved along; otherwise it allocates and moves element-wise.
+    static constexpr bool nothrow_move_assign =
+      Storage::owns_heap_buffer ? Storage::always_adopts : std::is_nothrow_move_constructible_v<value_type>;
+    static constexpr bool nothrow_swap =
+      Storage::owns_heap_buffer ? nothrow_move && nothrow_move_assign
+                                : std::is_nothrow_move_constructible_v<value_type> &&
+                                    std::is_nothrow_swappable_v<value_type>;
+
+    // Moves the newest elements that fit into fresh, linearized from its first
+    // slot, and makes it the storage. The old elements are destroyed.
+    VFC_CONSTEXPR20 void adopt_storage(Storage fresh) {
+      const size_type keep = std::min(size(), fresh.capacity());
+      auto it = begin() + static_cast<difference_type>(m_content_size - keep);
+      size_type moved = 0;
+      try {
+        for (; moved != keep; ++moved, ++it) {
+          fresh.construct(fresh.slots() + moved, std::move_if_noexcept(*it));
+        }
+      } catch (...) {
+        for (size_type i = 0; i != moved; ++i) {
+          fresh.destroy(fresh.slots() + i);
+        }
+        throw;
+      }
+      clear();
+      m_storage = std::move(fresh);
+      m_head = 0;
+      m_tail = keep;
+      m_content_size = keep;
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 const Storage& storage() const noexcept {
+      return m_storage;
+    }
+
   private:
-    friend class circular_container_iterator<CircularContainer<Tp, _capacity>, _capacity, false>;
-    friend class circular_container_iterator<CircularContainer<Tp, _capacity>, _capacity, true>;
-    friend class circular_container_reverse_iterator<CircularContainer<Tp, _capacity>, _capacity, false>;
-    friend class circular_container_reverse_iterator<CircularContainer<Tp, _capacity>, _capacity, true>;
-
-    std::array<value_type, _capacity + 1> m_buffer;
-    size_type m_capacity = _capacity + 1;
-    size_type m_content_size = 0;
-    size_type m_head = 0;
-    size_type m_tail = 0;
+    friend class circular_container_iterator<circular_container_base, false>;
+    friend class circular_container_iterator<circular_container_base, true>;
+    friend class circular_container_reverse_iterator<circular_container_base, false>;
+    friend class circular_container_reverse_iterator<circular_container_base, true>;
+
+    [[nodiscard]] VFC_CONSTEXPR20 size_type next_index(size_type index) const noexcept {
+      return m_storage.next_index(index);
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 size_type prev_index(size_type index) const noexcept {
+      return m_storage.prev_index(index);
+    }
+
+    // Logical position of a raw index relative to front(), used by the iterators.
+    [[nodiscard]] VFC_CONSTEXPR20 difference_type offset_of(size_type index) const noexcept {
+      return static_cast<difference_type>(m_storage.distance(m_head, index));
+    }
+
+    // Same for reverse iterators, whose rend() sits one slot before front().
+    [[nodiscard]] VFC_CONSTEXPR20 difference_type reverse_offset_of(size_type index) const noexcept {
+      return static_cast<difference_type>(m_storage.distance(m_storage.prev_index(m_head), index)) - 1;
+    }
+
+    // Raw index of the slot at a logical position, which may lie before front()
+    // as long as the distance stays within one buffer.
+    [[nodiscard]] VFC_CONSTEXPR20 size_type index_at(difference_type offset) const noexcept {
+      if constexpr (Storage::is_power_of_two) {
+        return static_cast<index_type>(m_head + static_cast<size_type>(offset));
+      } else {
+        return offset < 0 ? m_storage.retreat(m_head, static_cast<size_type>(-offset))
+                          : m_storage.advance(m_head, static_cast<size_type>(offset));
+      }
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 pointer slot_ptr(size_type index) noexcept {
+      return m_storage.slots() + m_storage.slot(index);
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 const_pointer slot_ptr(size_type index) const noexcept {
+      return m_storage.slots() + m_storage.slot(index);
+    }
+
+    template<typename... Args>
+    VFC_CONSTEXPR20 void construct(pointer target, Args&&... args) {
+      prepare_constant_slots();
+      m_storage.construct(target, std::forward<Args>(args)...);
+    }
+
+    // A constant expression may not hold indeterminate values, so when the
+    // first element is added during constant evaluation every slot of a
+    // trivially destructible type is value-initialized (such slots are never
+    // destroyed). Does nothing at run time.
+    VFC_CONSTEXPR20 void prepare_constant_slots() {
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+      if constexpr (std::is_trivially_destructible_v<value_type> && std::is_default_constructible_v<value_type>) {
+        if (std::is_constant_evaluated() && m_content_size == 0) {
+          for (size_type i = 0; i != m_storage.buffer_size(); ++i) {
+            m_storage.construct(m_storage.slots() + i);
+          }
+        }
+      }
+#endif
+    }
+
+    // Destroys count elements starting at the raw index first.
+    VFC_CONSTEXPR20 void destroy(size_type first, size_type count) noexcept {
+      if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for (; count != 0; --count, first = m_storage.next_index(first)) {
+          m_storage.destroy(slot_ptr(first));
+        }
+      }
+    }
+
+    // Takes over the indices of other, whose heap buffer was just handed over.
+    VFC_CONSTEXPR20 void take_indices(circular_container_base& other) noexcept {
+      m_content_size = std::exchange(other.m_content_size, 0);
+      m_head = std::exchange(other.m_head, 0);
+      m_tail = std::exchange(other.m_tail, 0);
+    }
+
+    // Copies or moves other's elements into *this, linearized from the first
+    // slot: one bulk copy per run of other (a memcpy for trivially copyable
+    // elements), so the cost follows other.size(), not the capacity. *this is
+    // empty, with its indices at 0, and has other's capacity.
+    template<typename Container>
+    VFC_CONSTEXPR20 void construct_from(Container&& other) {
+      prepare_constant_slots();
+      const auto append_run = [this](auto run) {
+        const pointer target = m_storage.slots() + m_content_size;
+        if constexpr (std::is_lvalue_reference_v<Container>) {
+          m_storage.uninitialized_copy(run.first, run.first + run.second, target);
+        } else {
+          m_storage.uninitialized_copy(std::make_move_iterator(run.first),
+                                       std::make_move_iterator(run.first + run.second), target);
+        }
+        m_content_size += run.second;
+        m_tail = m_content_size;
+      };
+      try {
+        append_run(other.array_one());
+        append_run(other.array_two());
+      } catch (...) {
+        clear();
+        throw;
+      }
+    }
+
+    // Swaps the first min(size(), other.size()) elements of both sides, then
+    // moves the remaining ones of the longer side to the back of the other.
+    VFC_CONSTEXPR20 void swap_elements(circular_container_base& other) {
+      circular_container_base& longer = m_content_size >= other.m_content_size ? *this : other;
+      circular_container_base& shorter = &longer == this ? other : *this;
+      const size_type common = shorter.m_content_size;
+      size_type from = longer.m_head;
+      for (size_type i = 0, to = shorter.m_head; i < common; ++i) {
+        using std::swap;
+        swap(*longer.slot_ptr(from), *shorter.slot_ptr(to));
+        from = m_storage.next_index(from);
+        to = m_storage.next_index(to);
+      }
+      const size_type rest = longer.m_content_size - common;
+      for (size_type i = 0; i < rest; ++i, from = m_storage.next_index(from)) {
+        shorter.construct(shorter.slot_ptr(shorter.m_tail), std::move(*longer.slot_ptr(from)));
+        shorter.grow_back();
+      }
+      longer.drop_back(rest);
+    }
+
+    // Only a heap buffer can have capacity 0 (DynamicCircularContainer(0), or
+    // one moved from). Such a ring keeps nothing: a pushed element counts as
+    // pushed and at once overwritten (rejected with reject_when_full, handed
+    // to evict_to's callback), and true is returned.
+    template<typename Arg>
+    VFC_CONSTEXPR20 bool discard_without_room(Arg&& item) {
+      if constexpr (Storage::owns_heap_buffer) {
+        if (capacity() == 0) {
+          if constexpr (std::is_same_v<Overflow, reject_when_full>) {
+            record_reject(1);
+          } else {
+            if constexpr (detail::is_evict_policy_v<Overflow>) {
+              Overflow::callback(value_type(std::forward<Arg>(item)));
+            }
+            record_push(1, 1);
+          }
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // The emplace functions return the new element, which a ring of capacity
+    // 0 cannot hold.
+    VFC_CONSTEXPR20 void check_room(const char* message) const {
+      if constexpr (Storage::owns_heap_buffer) {
+        if (capacity() == 0) {
+          throw std::out_of_range(message);
+        }
+      }
+    }
+
+    // Constructs a new front element in the free slot before the head.
+    template<typename... Args>
+    VFC_CONSTEXPR20 reference construct_front(bool overwrite, Args&&... args) {
+      const size_type index = m_storage.prev_index(m_head);
+      construct(slot_ptr(index), std::forward<Args>(args)...);
+      m_head = index;
+      ++m_content_size;
+      record_push(1, overwrite);
+      return *slot_ptr(index);
+    }
+
+    // Constructs a new back element, dropping the oldest one if full.
+    template<typename... Args>
+    VFC_CONSTEXPR20 reference append(Args&&... args) {
+      if constexpr (detail::is_evict_policy_v<Overflow>) {
+        if (full()) {
+          // Built before the oldest element is handed over: args may refer to it.
+          value_type item(std::forward<Args>(args)...);
+          Overflow::callback(std::move(*slot_ptr(m_head)));
+          return store_back(std::move(item));
+        }
+      }
+      return store_back(std::forward<Args>(args)...);
+    }
+
+    // Hand the count elements that are about to be dropped from the front or
+    // the back of a full ring to evict_to's callback, oldest first.
+    VFC_CONSTEXPR20 void evict_front(size_type count) {
+      if constexpr (detail::is_evict_policy_v<Overflow>) {
+        for (size_type i = 0, index = m_head; i < count; ++i, index = m_storage.next_index(index)) {
+          Overflow::callback(std::move(*slot_ptr(index)));
+        }
+      }
+    }
+
+    VFC_CONSTEXPR20 void evict_back(size_type count) {
+      if constexpr (detail::is_evict_policy_v<Overflow>) {
+        for (size_type i = 0, index = m_storage.retreat(m_tail, count); i < count;
+             ++i, index = m_storage.next_index(index)) {
+          Overflow::callback(std::move(*slot_ptr(index)));
+        }
+      }
+    }
+
+    // append() without the eviction callback.
+    template<typename... Args>
+    VFC_CONSTEXPR20 reference store_back(Args&&... args) {
+      // The bookkeeping is read before the element is written: narrow indices
+      // may alias a char or same-width integer element, which would otherwise
+      // force them to be reloaded after the store.
+      index_type head = m_head;
+      const index_type tail = m_tail;
+      index_type count = m_content_size;
+      const bool overwrite = count == capacity();
+      const pointer target = slot_ptr(tail);
+      if constexpr (Storage::is_power_of_two) {
+        if (count == capacity()) {
+          // Without a spare slot the tail still holds the oldest element. A
+          // copy or move of a whole element is assigned over it, which also
+          // covers push_back(front()); anything else is constructed in place
+          // once the oldest element has been destroyed.
+          if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, value_type> && ...)) {
+            *target = (std::forward<Args>(args), ...);
+            advance_tail(head, tail, count);
+            record_push(1, 1);
+            return *target;
+          } else {
+            destroy(head, 1);
+            m_head = head = m_storage.next_index(head);
+            m_content_size = --count;
+          }
+        }
+      }
+      construct(target, std::forward<Args>(args)...);
+      if (count == capacity()) {
+        destroy(head, 1);
+      }
+      advance_tail(head, tail, count);
+      record_push(1, overwrite);
+      return *target;
+    }
+
+    // Copies the count elements starting at first into the free slots after
+    // back(), in at most two contiguous runs.
+    template<typename ForwardIt>
+    VFC_CONSTEXPR20 void append_range(ForwardIt first, size_type count) {
+      prepare_constant_slots();
+      const size_type start = m_storage.slot(m_tail);
+      const size_type first_part = std::min(count, m_storage.buffer_size() - start);
+      const auto middle = std::next(first, first_part);
+      m_storage.uninitialized_copy(first, middle, m_storage.slots() + start);
+      m_tail = m_storage.advance(m_tail, first_part);
+      m_content_size += first_part;
+      m_storage.uninitialized_copy(middle, std::next(middle, count - first_part), m_storage.slots());
+      m_tail = m_storage.advance(m_tail, count - first_part);
+      m_content_size += count - first_part;
+    }
+
+    // Commits the element just written at tail, dropping the oldest one if
+    // full; head, tail and count are the values read before the write.
+    VFC_CONSTEXPR20 void advance_tail(index_type head, index_type tail, index_type count) noexcept {
+      m_tail = m_storage.next_index(tail);
+      if (count == capacity()) {
+        m_head = m_storage.next_index(head);
+      } else {
+        m_content_size = count + 1;
+      }
+    }
+
+    template<typename Arg>
+    VFC_CONSTEXPR20 iterator insert_one(iterator pos, Arg&& item) {
+      if (pos == end()) {
+        if (full()) {
+          record_reject(1);
+          return end();
+        }
+        construct(slot_ptr(m_tail), std::forward<Arg>(item));
+        grow_back();
+        record_push(1, 0);
+        return pos;
+      }
+      const size_type offset = static_cast<size_type>(offset_of(pos.index()));
+      const bool overwrite = full();
+      if (overwrite) {
+        evict_back(1);
+        drop_back(1);
+      }
+      const size_type index = open_gap(offset, 1);
+      try {
+        construct(slot_ptr(index), std::forward<Arg>(item));
+      } catch (...) {
+        close_gap(offset, 1);
+        throw;
+      }
+      record_push(1, overwrite);
+      return iterator(*this, index);
+    }
+
+    // Destroys the count oldest elements (count <= size()).
+    VFC_CONSTEXPR20 void drop_front(size_type count) noexcept {
+      destroy(m_head, count);
+      m_head = m_storage.advance(m_head, count);
+      m_content_size -= count;
+    }
+
+    // Destroys the count newest elements (count <= size()).
+    VFC_CONSTEXPR20 void drop_back(size_type count) noexcept {
+      m_tail = m_storage.retreat(m_tail, count);
+      destroy(m_tail, count);
+      m_content_size -= count;
+    }
+
+    // Opens count uninitialized slots before the element at logical position
+    // offset and returns the raw index of the first one. The elements on the
+    // shorter side of offset are moved outwards; the gap counts towards size()
+    // and must fit (size() + count <= capacity()).
+    VFC_CONSTEXPR20 size_type open_gap(size_type offset, size_type count) {
+      const size_type suffix = m_content_size - offset;
+      record_shift(std::min(offset, suffix));
+      if (offset < suffix) {
+        // The first elements go into free slots before front(), the rest are
+        // assigned, and the moved-from leftovers in the gap are destroyed.
+        const size_type new_head = m_storage.retreat(m_head, count);
+        const size_type constructed = std::min(offset, count);
+        move_construct(m_head, new_head, constructed);
+        move_towards_front(m_storage.advance(m_head, constructed), m_storage.advance(new_head, constructed),
+                           offset - constructed);
+        destroy(m_storage.advance(m_head, offset - constructed), constructed);
+        m_head = new_head;
+      } else {
+        const size_type new_tail = m_storage.advance(m_tail, count);
+        const size_type constructed = std::min(suffix, count);
+        const size_type from_end = m_storage.retreat(m_tail, constructed);
+        const size_type to_end = m_storage.retreat(new_tail, constructed);
+        move_construct(from_end, to_end, constructed);
+        move_towards_back(from_end, to_end, suffix - constructed);
+        destroy(index_at(static_cast<difference_type>(offset)), constructed);
+        m_tail = new_tail;
+      }
+      m_content_size += count;
+      return index_at(static_cast<difference_type>(offset));
+    }
+
+    // Closes a gap of count uninitialized slots at logical position offset
+    // (counted in size()) by moving the shorter side inwards.
+    VFC_CONSTEXPR20 void close_gap(size_type offset, size_type count) {
+      const size_type suffix = m_content_size - offset - count;
+      record_shift(std::min(offset, suffix));
+      const size_type gap_begin = index_at(static_cast<difference_type>(offset));
+      const size_type gap_end = m_storage.advance(gap_begin, count);
+      if (offset < suffix) {
+        const size_type constructed = std::min(offset, count);
+        const size_type from_end = m_storage.retreat(gap_begin, constructed);
+        const size_type to_end = m_storage.retreat(gap_end, constructed);
+        move_construct(from_end, to_end, constructed);
+        move_towards_back(from_end, to_end, offset - constructed);
+        destroy(m_head, constructed);
+        m_head = m_storage.advance(m_head, count);
+      } else {
+        const size_type constructed = std::min(suffix, count);
+        move_construct(gap_end, gap_begin, constructed);
+        move_towards_front(m_storage.advance(gap_end, constructed), m_storage.advance(gap_begin, constructed),
+                           suffix - constructed);
+        destroy(m_storage.retreat(m_tail, constructed), constructed);
+        m_tail = m_storage.retreat(m_tail, count);
+      }
+      m_content_size -= count;
+    }
+
+    // Move-constructs count elements from the raw index from into the
+    // uninitialized slots starting at the raw index to.
+    VFC_CONSTEXPR20 void move_construct(size_type from, size_type to, size_type count) {
+      for (; count != 0; --count, from = m_storage.next_index(from), to = m_storage.next_index(to)) {
+        construct(slot_ptr(to), std::move(*slot_ptr(from)));
+      }
+    }
+
+    // Move-assigns count elements from the raw index from to the raw index to,
+    // which lies before it, one contiguous run at a time.
+    VFC_CONSTEXPR20 void move_towards_front(size_type from, size_type to, size_type count) {
+      const pointer slots = m_storage.slots();
+      while (count != 0) {
+        const size_type source = m_storage.slot(from);
+        const size_type target = m_storage.slot(to);
+        const size_type run = std::min({count, m_storage.buffer_size() - source, m_storage.buffer_size() - target});
+        std::move(slots + source, slots + source + run, slots + target);
+        from = m_storage.advance(from, run);
+        to = m_storage.advance(to, run);
+        count -= run;
+      }
+    }
+
+    // Move-assigns the count elements ending before the raw index from_end to
+    // the slots ending before to_end, which lies after it, back to front.
+    VFC_CONSTEXPR20 void move_towards_back(size_type from_end, size_type to_end, size_type count) {
+      const pointer slots = m_storage.slots();
+      while (count != 0) {
+        const size_type source_end = m_storage.slot(m_storage.prev_index(from_end)) + 1;
+        const size_type target_end = m_storage.slot(m_storage.prev_index(to_end)) + 1;
+        const size_type run = std::min({count, source_end, target_end});
+        std::move_backward(slots + source_end - run, slots + source_end, slots + target_end);
+        from_end = m_storage.retreat(from_end, run);
+        to_end = m_storage.retreat(to_end, run);
+        count -= run;
+      }
+    }
+
+    [[nodiscard]] VFC_CONSTEXPR20 size_type first_run_size() const noexcept {
+      return std::min(size(), m_storage.buffer_size() - m_storage.slot(m_head));
+    }
+
+    // Stats hooks; compiled out with no_stats. record_push is called once the
+    // elements are in, overwritten of them having replaced older ones.
+    VFC_CONSTEXPR20 void record_push(size_type count, size_type overwritten) noexcept {
+      if constexpr (Stats::enabled) {
+        Stats::on_push(count, m_content_size);
+        if (overwritten != 0) {
+          Stats::on_overwrite(overwritten);
+        }
+      }
+    }
+
+    VFC_CONSTEXPR20 void record_pop(size_type count) noexcept {
+      if constexpr (Stats::enabled) {
+        Stats::on_pop(count);
+      }
+    }
+
+    VFC_CONSTEXPR20 void record_reject(size_type count) noexcept {
+      if constexpr (Stats::enabled) {
+        Stats::on_reject(count);
+      }
+    }
+
+    VFC_CONSTEXPR20 void record_shift(size_type count) noexcept {
+      if constexpr (Stats::enabled) {
+        Stats::on_shift(count);
+      }
+    }
+
+    VFC_CONSTEXPR20 void grow_back() noexcept {
+      if (!full()) {
+        m_tail = m_storage.next_index(m_tail);
+        ++m_content_size;
+      }
+    }
+
+    // The bookkeeping uses Storage::index_type, which for a fixed capacity is
+    // the smallest unsigned type that holds it. pop_front writes m_head and the
+    // size, push_back m_tail and the size; see cache_aligned_layout.
+    Storage m_storage;
+    alignas(index_type) alignas(layout_policy::index_alignment) index_type m_head = 0;
+    alignas(index_type) alignas(layout_policy::index_alignment) index_type m_tail = 0;
+    index_type m_content_size = 0;
+};
+} // namespace detail
+
+// Circular Container class implementation: ///
+template<typename Tp, std::size_t _capacity, typename OverflowPolicy = overwrite_oldest,
+         typename LayoutPolicy = compact_layout, typename StatsPolicy = no_stats>
+class CircularContainer
+  : public detail::circular_container_base<Tp, detail::fixed_ring_storage<Tp, _capacity, LayoutPolicy>, OverflowPolicy,
+                                           StatsPolicy> {
+    using base = detail::circular_container_base<Tp, detail::fixed_ring_storage<Tp, _capacity, LayoutPolicy>,
+                                                 OverflowPolicy, StatsPolicy>;
+
+  public:
+    VFC_CONSTEXPR20 CircularContainer() noexcept {}
+
+    // For policies that carry state, such as evict_to with a capturing lambda.
+    VFC_CONSTEXPR20 explicit CircularContainer(const OverflowPolicy& policy) : base(std::in_place, policy) {
+    }
+
+    // Enable CircularContainer class to be brace initialized:
+    VFC_CONSTEXPR20 explicit CircularContainer(std::initializer_list<Tp> values) {
+      for (auto& item : values) {
+        this->emplace(this->end(), item);
+      }
+    }
 };
 
 // Deduction to enable CircularContainer class to be brace initialized: //
@@ -0,0 +1,224 @@
+#ifndef DYNAMICCIRCULARCONTAINER_H_
+#define DYNAMICCIRCULARCONTAINER_H_
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "CircularContainer.hpp"
+
+namespace vfc {
+namespace detail {
+// Storage policy of DynamicCircularContainer: a heap buffer of capacity + 1
+// slots obtained from the allocator. Indices wrap by comparison, as for a
+// fixed capacity that is not a power of two, so any capacity is exact.
+template<typename Tp, typename Allocator>
+class dynamic_ring_storage {
+  public:
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Tp>;
+    using index_type = std::size_t;
+    using layout_policy = compact_layout;
+    static constexpr bool is_power_of_two = false;
+    static constexpr bool owns_heap_buffer = true;
+    // Whether move assignment can always take over the other buffer.
+    static constexpr bool always_adopts =
+      std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+      std::allocator_traits<allocator_type>::is_always_equal::value;
+
+    dynamic_ring_storage(std::size_t capacity, const allocator_type& alloc)
+      : m_alloc(alloc), m_buffer_size(capacity + 1), m_slots(alloc_traits::allocate(m_alloc, m_buffer_size)) {
+    }
+
+    // Copies get an empty buffer of the same capacity; the container copies
+    // the elements.
+    dynamic_ring_storage(const dynamic_ring_storage& other)
+      : dynamic_ring_storage(other.capacity(), alloc_traits::select_on_container_copy_construction(other.m_alloc)) {
+    }
+
+    dynamic_ring_storage(dynamic_ring_storage&& other) noexcept
+      : m_alloc(std::move(other.m_alloc)),
+        m_buffer_size(std::exchange(other.m_buffer_size, 1)),
+        m_slots(std::exchange(other.m_slots, nullptr)) {
+    }
+
+    // Takes over other's buffer; only used when the allocators allow it.
+    dynamic_ring_storage& operator=(dynamic_ring_storage&& other) noexcept {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        m_alloc = std::move(other.m_alloc);
+      }
+      m_buffer_size = std::exchange(other.m_buffer_size, 1);
+      m_slots = std::exchange(other.m_slots, nullptr);
+      return *this;
+    }
+
+    dynamic_ring_storage& operator=(const dynamic_ring_storage&) = delete;
+
+    ~dynamic_ring_storage() {
+      release();
+    }
+
+    // Makes this (empty) storage able to receive a copy of other's elements.
+    void assign_empty(const dynamic_ring_storage& other) {
+      bool reallocate = m_buffer_size != other.m_buffer_size || !m_slots;
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (m_alloc != other.m_alloc) {
+          release();
+          m_alloc = other.m_alloc;
+          reallocate = true;
+        }
+      }
+      if (reallocate) {
+        release();
+        m_slots = alloc_traits::allocate(m_alloc, other.m_buffer_size);
+        m_buffer_size = other.m_buffer_size;
+      }
+    }
+
+    // Takes over other's buffer if the allocators allow it and returns true;
+    // otherwise makes this storage able to receive other's elements.
+    bool adopt(dynamic_ring_storage&& other) {
+      if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+        if (m_alloc != other.m_alloc) {
+          assign_empty(other);
+          return false;
+        }
+      }
+      *this = std::move(other);
+      return true;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_buffer_size - 1; }
+    [[nodiscard]] std::size_t buffer_size() const noexcept { return m_buffer_size; }
+    [[nodiscard]] static constexpr std::size_t slot(std::size_t index) noexcept { return index; }
+
+    [[nodiscard]] std::size_t next_index(std::size_t index) const noexcept {
+      return index + 1 == m_buffer_size ? 0 : index + 1;
+    }
+
+    [[nodiscard]] std::size_t prev_index(std::size_t index) const noexcept {
+      return index == 0 ? m_buffer_size - 1 : index - 1;
+    }
+
+    [[nodiscard]] std::size_t advance(std::size_t index, std::size_t count) const noexcept {
+      return index + count >= m_buffer_size ? index + count - m_buffer_size : index + count;
+    }
+
+    [[nodiscard]] std::size_t retreat(std::size_t index, std::size_t count) const noexcept {
+      return index >= count ? index - count : index + m_buffer_size - count;
+    }
+
+    [[nodiscard]] std::size_t distance(std::size_t head, std::size_t tail) const noexcept {
+      return tail >= head ? tail - head : tail + m_buffer_size - head;
+    }
+
+    [[nodiscard]] Tp* slots() noexcept { return m_slots; }
+    [[nodiscard]] const Tp* slots() const noexcept { return m_slots; }
+
+    [[nodiscard]] const allocator_type& allocator() const noexcept { return m_alloc; }
+
+    // Elements are constructed through the allocator so that allocator-aware
+    // types (e.g. std::pmr::string) pick up the container's resource.
+    template<typename... Args>
+    void construct(Tp* target, Args&&... args) {
+      alloc_traits::construct(m_alloc, target, std::forward<Args>(args)...);
+    }
+
+    void destroy(Tp* target) noexcept {
+      alloc_traits::destroy(m_alloc, target);
+    }
+
+    template<typename ForwardIt>
+    Tp* uninitialized_copy(ForwardIt first, ForwardIt last, Tp* out) {
+      if constexpr (std::is_same_v<allocator_type, std::allocator<Tp>>) {
+        return std::uninitialized_copy(first, last, out);
+      } else {
+        Tp* current = out;
+        try {
+          for (; first != last; ++first, ++current) {
+            construct(current, *first);
+          }
+        } catch (...) {
+          for (; out != current; ++out) {
+            destroy(out);
+          }
+          throw;
+        }
+        return current;
+      }
+    }
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    void release() noexcept {
+      if (m_slots) {
+        alloc_traits::deallocate(m_alloc, m_slots, m_buffer_size);
+        m_slots = nullptr;
+      }
+    }
+
+    allocator_type m_alloc;
+    std::size_t m_buffer_size;
+    Tp* m_slots;
+};
+} // namespace detail
+
+// CircularContainer whose capacity is chosen at run time. The elements live
+// in a buffer obtained from Allocator, so large rings do not bloat the object
+// and moves are O(1). Apart from the constructors and the capacity management
+// below, the API and iterators are those of CircularContainer.
+//
+// A moved-from container is empty with capacity 0, like
+// DynamicCircularContainer(0): pushes drop their element at once and the
+// emplace functions, which would return it, throw std::out_of_range. reserve,
+// resize_capacity or assignment give it room again.
+template<typename Tp, typename Allocator = std::allocator<Tp>, typename OverflowPolicy = overwrite_oldest,
+         typename StatsPolicy = no_stats>
+class DynamicCircularContainer
+  : public detail::circular_container_base<Tp, detail::dynamic_ring_storage<Tp, Allocator>, OverflowPolicy,
+                                           StatsPolicy> {
+    using storage_type = detail::dynamic_ring_storage<Tp, Allocator>;
+    using base = detail::circular_container_base<Tp, storage_type, OverflowPolicy, StatsPolicy>;
+
+  public:
+    using allocator_type = Allocator;
+    using typename base::size_type;
+
+    explicit DynamicCircularContainer(size_type capacity, const allocator_type& alloc = allocator_type())
+      : base(std::in_place, OverflowPolicy(), capacity, alloc) {
+    }
+
+    DynamicCircularContainer(size_type capacity, const OverflowPolicy& policy,
+                             const allocator_type& alloc = allocator_type())
+      : base(std::in_place, policy, capacity, alloc) {
+    }
+
+    DynamicCircularContainer(size_type capacity, std::initializer_list<Tp> values,
+                             const allocator_type& alloc = allocator_type())
+      : base(std::in_place, OverflowPolicy(), capacity, alloc) {
+      for (auto& item : values) {
+        this->emplace(this->end(), item);
+      }
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+      return allocator_type(this->storage().allocator());
+    }
+
+    // Grows the capacity to at least new_capacity; never shrinks.
+    void reserve(size_type new_capacity) {
+      if (new_capacity > this->capacity()) {
+        resize_capacity(new_capacity);
+      }
+    }
+
+    // Reallocates the buffer with exactly new_capacity slots and moves the
+    // elements into it linearized. When shrinking below size(), the newest
+    // new_capacity elements are kept. Invalidates iterators.
+    void resize_capacity(size_type new_capacity) {
+      this->adopt_storage(storage_type(new_capacity, this->storage().allocator()));
+    }
+};
+}
+
+#endif // DYNAMICCIRCULARCONTAINER_H_
@@ -0,0 +1,295 @@
+#ifndef MIRROREDCIRCULARCONTAINER_H_
+#define MIRROREDCIRCULARCONTAINER_H_
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace vfc {
+// Ring of trivially copyable elements (typically bytes) whose buffer is mapped
+// twice, back to back, from the same memfd. Slot i and slot i + capacity()
+// alias, so the size() elements starting at front() are always one contiguous
+// range and no reader or writer ever sees the wrap-around. Linux only.
+//
+// The capacity is rounded up so that the buffer is a whole number of pages.
+// push_back keeps CircularContainer's semantics and drops the oldest element
+// when full; contiguous_write/commit_write only ever use the free space.
+// A moved-from ring is unmapped and has capacity 0: pushes drop their
+// elements and contiguous_write offers no space.
+template<typename Tp>
+class MirroredCircularContainer {
+    static_assert(std::is_trivially_copyable_v<Tp>, "MirroredCircularContainer stores raw, mapped memory");
+
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    // Every window is contiguous, so plain pointers are the iterators.
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using array_range = std::pair<pointer, size_type>;
+    using const_array_range = std::pair<const_pointer, size_type>;
+
+    // Maps a buffer for at least min_capacity elements; throws std::system_error
+    // if the kernel refuses.
+    explicit MirroredCircularContainer(size_type min_capacity) {
+      const auto page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+      const size_type granule = std::lcm(page, sizeof(value_type));
+      m_bytes = std::max<size_type>(1, (min_capacity * sizeof(value_type) + granule - 1) / granule) * granule;
+      m_capacity = m_bytes / sizeof(value_type);
+      map();
+    }
+
+    MirroredCircularContainer(const MirroredCircularContainer& other) = delete;
+    MirroredCircularContainer& operator=(const MirroredCircularContainer& other) = delete;
+
+    MirroredCircularContainer(MirroredCircularContainer&& other) noexcept
+      : m_buffer(std::exchange(other.m_buffer, nullptr)),
+        m_bytes(std::exchange(other.m_bytes, 0)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_head(std::exchange(other.m_head, 0)),
+        m_content_size(std::exchange(other.m_content_size, 0)) {
+    }
+
+    MirroredCircularContainer& operator=(MirroredCircularContainer&& other) noexcept {
+      if (this != &other) {
+        unmap();
+        m_buffer = std::exchange(other.m_buffer, nullptr);
+        m_bytes = std::exchange(other.m_bytes, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_head = std::exchange(other.m_head, 0);
+        m_content_size = std::exchange(other.m_content_size, 0);
+      }
+      return *this;
+    }
+
+    ~MirroredCircularContainer() {
+      unmap();
+    }
+
+    // Modifiers
+    void push_back(const value_type& item) {
+      if (full()) {
+        if (!m_capacity) {
+          return; // moved-from
+        }
+        pop_front();
+      }
+      m_buffer[m_head + m_content_size] = item;
+      ++m_content_size;
+    }
+
+    // Appends [items, items + count) as if by repeated push_back.
+    void push_back(const_pointer items, size_type count) {
+      if (count >= m_capacity) {
+        if (!m_capacity) {
+          return; // moved-from
+        }
+        items += count - m_capacity;
+        count = m_capacity;
+      }
+      if (count > m_capacity - m_content_size) {
+        pop_front(count - (m_capacity - m_content_size));
+      }
+      std::memcpy(m_buffer + m_head + m_content_size, items, count * sizeof(value_type));
+      m_content_size += count;
+    }
+
+    void pop_front() {
+      pop_front(1);
+    }
+
+    // Removes the count oldest elements (all of them if count >= size()).
+    void pop_front(size_type count) {
+      if (count >= m_content_size) {
+        clear();
+        return;
+      }
+      m_head += count;
+      if (m_head >= m_capacity) {
+        m_head -= m_capacity;
+      }
+      m_content_size -= count;
+    }
+
+    void clear() noexcept {
+      m_head = 0;
+      m_content_size = 0;
+    }
+
+    // Zero-copy access:
+    // The oldest min(count, size()) elements as one range; consume them with
+    // pop_front().
+    [[nodiscard]] const_array_range contiguous_read(size_type count) const noexcept {
+      return {m_buffer + m_head, std::min(count, m_content_size)};
+    }
+
+    // Free space for up to count new elements after back(), as one range; fill
+    // a prefix of it and publish that with commit_write().
+    [[nodiscard]] array_range contiguous_write(size_type count) noexcept {
+      return {m_buffer + m_head + m_content_size, std::min(count, m_capacity - m_content_size)};
+    }
+
+    // Appends the count elements written through contiguous_write().
+    void commit_write(size_type count) {
+      if (count > m_capacity - m_content_size) {
+        throw std::out_of_range("MirroredCircularContainer::commit_write() - count exceeds the free space");
+      }
+      m_content_size += count;
+    }
+
+    // Capacity:
+    [[nodiscard]] size_type capacity() const noexcept {
+      return m_capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return !m_content_size;
+    }
+
+    [[nodiscard]] bool full() const noexcept {
+      return m_content_size == m_capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      return m_content_size;
+    }
+
+    // Iterators:
+    iterator begin() noexcept { return m_buffer + m_head; }
+
+    iterator end() noexcept { return m_buffer + m_head + m_content_size; }
+
+    const_iterator begin() const noexcept { return m_buffer + m_head; }
+
+    const_iterator end() const noexcept { return m_buffer + m_head + m_content_size; }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    // Element access:
+    [[nodiscard]] pointer data() noexcept {
+      return m_buffer + m_head;
+    }
+
+    [[nodiscard]] const_pointer data() const noexcept {
+      return m_buffer + m_head;
+    }
+
+    reference operator[](size_type pos) {
+      return m_buffer[m_head + pos];
+    }
+
+    const_reference operator[](size_type pos) const {
+      return m_buffer[m_head + pos];
+    }
+
+    reference at(size_type pos) {
+      if (pos >= m_content_size) {
+        throw std::out_of_range("MirroredCircularContainer::at() - index out of range");
+      }
+      return (*this)[pos];
+    }
+
+    const_reference at(size_type pos) const {
+      if (pos >= m_content_size) {
+        throw std::out_of_range("MirroredCircularContainer::at() - index out of range");
+      }
+      return (*this)[pos];
+    }
+
+    reference front() {
+      if (empty()) {
+        throw std::out_of_range("MirroredCircularContainer::front() - container is empty");
+      }
+      return *begin();
+    }
+
+    reference back() {
+      if (empty()) {
+        throw std::out_of_range("MirroredCircularContainer::back() - container is empty");
+      }
+      return *(end() - 1);
+    }
+
+    const_reference front() const {
+      if (empty()) {
+        throw std::out_of_range("MirroredCircularContainer::front() - container is empty");
+      }
+      return *begin();
+    }
+
+    const_reference back() const {
+      if (empty()) {
+        throw std::out_of_range("MirroredCircularContainer::back() - container is empty");
+      }
+      return *(end() - 1);
+    }
+
+  private:
+    // Reserves 2 * m_bytes of address space and maps the memfd into both halves.
+    void map() {
+      const int fd = ::memfd_create("vfc_mirrored_ring", MFD_CLOEXEC);
+      if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), "memfd_create");
+      }
+      void* region = MAP_FAILED;
+      try {
+        if (::ftruncate(fd, static_cast<off_t>(m_bytes)) == -1) {
+          throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+        region = ::mmap(nullptr, 2 * m_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+          throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        auto* base = static_cast<char*>(region);
+        for (char* half : {base, base + m_bytes}) {
+          if (::mmap(half, m_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+          }
+        }
+      } catch (...) {
+        if (region != MAP_FAILED) {
+          ::munmap(region, 2 * m_bytes);
+        }
+        ::close(fd);
+        throw;
+      }
+      // The mappings keep the memory alive.
+      ::close(fd);
+      m_buffer = static_cast<pointer>(region);
+    }
+
+    void unmap() noexcept {
+      if (m_buffer) {
+        ::munmap(m_buffer, 2 * m_bytes);
+        m_buffer = nullptr;
+      }
+    }
+
+    pointer m_buffer = nullptr;
+    size_type m_bytes = 0;
+    size_type m_capacity = 0;
+    size_type m_head = 0;
+    size_type m_content_size = 0;
+};
+}
+
+#endif // __linux__
+
+#endif // MIRROREDCIRCULARCONTAINER_H_
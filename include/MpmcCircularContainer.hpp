@@ -0,0 +1,198 @@
+#ifndef MPMCCIRCULARCONTAINER_H_
+#define MPMCCIRCULARCONTAINER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include "CircularContainer.hpp"
+
+namespace vfc {
+// Bounded multi-producer/multi-consumer ring. Every slot carries a sequence
+// number telling whether it is ready to be written (sequence == position) or
+// read (sequence == position + 1) on the current lap, so producers and
+// consumers only contend on their own position counter. Positions are claimed
+// with seq_cst compare-exchanges (no dearer than relaxed ones on x86), which
+// BlockingCircularContainer relies on to skip a fence when nobody sleeps.
+//
+// try_push/try_pop never block and fail on a full/empty ring. push_back keeps
+// CircularContainer's semantics and drops the oldest element to make room; if
+// it races with consumers it may discard an element that a consumer would
+// otherwise have popped first, but never more than one per attempt.
+//
+// Stats (no_stats by default, atomic_stats to enable) counts the elements
+// pushed, popped, discarded by push_back and refused by try_push, and the
+// peak size(); see stats().
+template<typename Tp, std::size_t _capacity, typename Stats = no_stats>
+class MpmcCircularContainer : private Stats {
+    static_assert(_capacity > 0, "MpmcCircularContainer needs at least one slot");
+
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    MpmcCircularContainer() {
+      for (size_type i = 0; i < _capacity; ++i) {
+        m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+    MpmcCircularContainer(const MpmcCircularContainer& other) = delete;
+    MpmcCircularContainer& operator=(const MpmcCircularContainer& other) = delete;
+    ~MpmcCircularContainer() = default;
+
+    // Producers:
+    bool try_push(const value_type& item) {
+      return try_emplace(item);
+    }
+
+    bool try_push(value_type&& item) {
+      return try_emplace(std::move(item));
+    }
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+      if (emplace_if_room(std::forward<Args>(args)...)) {
+        return true;
+      }
+      if constexpr (Stats::enabled) {
+        Stats::on_reject(1);
+      }
+      return false;
+    }
+
+    // Appends an element, dropping the oldest one if the ring is full.
+    void push_back(const value_type& item) {
+      while (!emplace_if_room(item)) {
+        discard_oldest();
+      }
+    }
+
+    void push_back(value_type&& item) {
+      while (!emplace_if_room(std::move(item))) {
+        discard_oldest();
+      }
+    }
+
+    // Consumers:
+    bool try_pop(value_type& item) {
+      size_type pos;
+      cell* target = claim_front(pos);
+      if (!target) {
+        return false;
+      }
+      item = std::move(target->value);
+      target->sequence.store(pos + _capacity, std::memory_order_release);
+      if constexpr (Stats::enabled) {
+        Stats::on_pop(1);
+      }
+      return true;
+    }
+
+    // Capacity (size() and empty() are only a snapshot under concurrency):
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+      return _capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      const size_type head = m_dequeue_pos.load(std::memory_order_acquire);
+      const size_type tail = m_enqueue_pos.load(std::memory_order_acquire);
+      const size_type count = tail > head ? tail - head : 0;
+      return count < _capacity ? count : _capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    // Snapshot of the counters kept by the stats policy (not with no_stats).
+    template<typename S = Stats>
+    [[nodiscard]] container_stats stats() const noexcept {
+      static_assert(S::enabled, "stats() needs a stats policy such as vfc::atomic_stats");
+      return Stats::snapshot();
+    }
+
+  private:
+    struct cell {
+      std::atomic<size_type> sequence;
+      value_type value;
+    };
+
+    // try_emplace without the rejection count, which push_back does not want.
+    template<typename... Args>
+    bool emplace_if_room(Args&&... args) {
+      size_type pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      cell* target;
+      for (;;) {
+        target = &m_buffer[slot(pos)];
+        const size_type sequence = target->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+          if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (diff < 0) {
+          return false; // full
+        } else {
+          pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+      }
+      target->value = value_type(std::forward<Args>(args)...);
+      target->sequence.store(pos + 1, std::memory_order_release);
+      if constexpr (Stats::enabled) {
+        Stats::on_push(1, size());
+      }
+      return true;
+    }
+
+    [[nodiscard]] static constexpr size_type slot(size_type pos) noexcept {
+      if constexpr (detail::ring_layout<_capacity>::is_power_of_two) {
+        return pos & (_capacity - 1);
+      } else {
+        return pos % _capacity;
+      }
+    }
+
+    // Claims the oldest published cell for reading, or returns nullptr if none is.
+    cell* claim_front(size_type& pos) {
+      pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      for (;;) {
+        cell* target = &m_buffer[slot(pos)];
+        const size_type sequence = target->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+          if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return target;
+          }
+        } else if (diff < 0) {
+          return nullptr; // empty, or the producer of this slot has not finished yet
+        } else {
+          pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    // Pops and destroys the front element unless the ring stopped being full.
+    void discard_oldest() {
+      const size_type head = m_dequeue_pos.load(std::memory_order_relaxed);
+      if (m_enqueue_pos.load(std::memory_order_relaxed) - head < _capacity) {
+        return;
+      }
+      size_type pos;
+      if (cell* target = claim_front(pos)) {
+        [[maybe_unused]] value_type discarded(std::move(target->value));
+        target->sequence.store(pos + _capacity, std::memory_order_release);
+        if constexpr (Stats::enabled) {
+          Stats::on_overwrite(1);
+        }
+      }
+    }
+
+    alignas(detail::cache_line_size) std::atomic<size_type> m_enqueue_pos{0};
+    alignas(detail::cache_line_size) std::atomic<size_type> m_dequeue_pos{0};
+    alignas(detail::cache_line_size) std::array<cell, _capacity> m_buffer;
+};
+}
+
+#endif // MPMCCIRCULARCONTAINER_H_
@@ -0,0 +1,500 @@
+#ifndef PERSISTENTCIRCULARCONTAINER_H_
+#define PERSISTENTCIRCULARCONTAINER_H_
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "CircularContainer.hpp"
+
+namespace vfc {
+namespace detail {
+// Start of a PersistentCircularContainer file. head and tail are
+// free-running positions (slot = position % capacity), so size is tail - head
+// and the pair can never describe a state that a full and an empty ring share.
+struct persistent_ring_header {
+  static constexpr std::uint64_t file_magic = 0x31474e4952434656; // "VFCRING1"
+  static constexpr std::uint32_t file_version = 1;
+
+  std::uint64_t magic;
+  std::uint32_t format_version;
+  std::uint32_t user_version;
+  std::uint64_t type_hash;
+  std::uint64_t element_size;
+  std::uint64_t element_align;
+  std::uint64_t capacity;
+  // Offset of the first slot: the page size of the host that created the
+  // file, which need not be the one reopening it.
+  std::uint64_t data_offset;
+  std::uint64_t head;
+  std::uint64_t tail;
+};
+
+// FNV-1a of the compiler's spelling of Tp, stable across builds made with the
+// same compiler (unlike std::type_info::hash_code).
+template<typename Tp>
+[[nodiscard]] std::uint64_t persistent_type_hash() noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325;
+  for (const char* c = __PRETTY_FUNCTION__; *c; ++c) {
+    hash = (hash ^ static_cast<unsigned char>(*c)) * 0x100000001b3;
+  }
+  return hash;
+}
+}
+
+// Ring of trivially copyable elements kept in a memory-mapped file, so its
+// contents survive the process. Opening an existing file maps it and picks up
+// head and tail from its header, which is O(1) whatever the capacity: the
+// pages are only read in when they are touched. Linux only.
+//
+// The file starts with the header (positions, capacity, element size and
+// alignment, a hash of the element type and a user version); the slots start
+// at the next page of the host that created it, and the header records where,
+// so hosts with other page sizes read them in place. Reopening checks all of
+// these and throws std::runtime_error on any mismatch rather than
+// reinterpreting the slots.
+//
+// Every modification writes the slots before it updates the header, so a
+// process that dies at any point leaves a consistent ring behind (at worst
+// without the element it was adding, or without the oldest one it was
+// overwriting). Surviving a machine crash needs the pages on disk: sync()
+// writes back what changed since the last call, and set_sync_interval(n) has
+// push_back call it every n elements.
+template<typename Tp>
+class PersistentCircularContainer {
+    static_assert(std::is_trivially_copyable_v<Tp>, "PersistentCircularContainer stores raw, mapped memory");
+
+    using header_type = detail::persistent_ring_header;
+
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = circular_container_iterator<PersistentCircularContainer, false>;
+    using const_iterator = circular_container_iterator<PersistentCircularContainer, true>;
+    using reverse_iterator = circular_container_reverse_iterator<PersistentCircularContainer, false>;
+    using const_reverse_iterator = circular_container_reverse_iterator<PersistentCircularContainer, true>;
+
+    // Opens the ring stored at path, creating an empty one with capacity slots
+    // if the file does not exist or is empty. A capacity of 0 accepts whatever
+    // capacity the existing file has. Throws std::system_error if a system
+    // call fails and std::runtime_error if the file holds a different ring.
+    PersistentCircularContainer(const std::string& path, size_type capacity, std::uint32_t version = 0) {
+      open(path, capacity, version);
+    }
+
+    PersistentCircularContainer(const PersistentCircularContainer& other) = delete;
+    PersistentCircularContainer& operator=(const PersistentCircularContainer& other) = delete;
+
+    PersistentCircularContainer(PersistentCircularContainer&& other) noexcept
+      : m_mapping(std::exchange(other.m_mapping, nullptr)),
+        m_bytes(std::exchange(other.m_bytes, 0)),
+        m_header(std::exchange(other.m_header, nullptr)),
+        m_slots(std::exchange(other.m_slots, nullptr)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_sync_interval(std::exchange(other.m_sync_interval, 0)),
+        m_synced(std::exchange(other.m_synced, 0)) {
+    }
+
+    PersistentCircularContainer& operator=(PersistentCircularContainer&& other) noexcept {
+      if (this != &other) {
+        unmap();
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_bytes = std::exchange(other.m_bytes, 0);
+        m_header = std::exchange(other.m_header, nullptr);
+        m_slots = std::exchange(other.m_slots, nullptr);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_sync_interval = std::exchange(other.m_sync_interval, 0);
+        m_synced = std::exchange(other.m_synced, 0);
+      }
+      return *this;
+    }
+
+    // Unmapping keeps the changes in the page cache, from where the kernel
+    // writes them back; with a sync interval set, they are synced first.
+    ~PersistentCircularContainer() {
+      if (m_mapping && m_sync_interval) {
+        try {
+          sync();
+        } catch (...) {
+        }
+      }
+      unmap();
+    }
+
+    // Modifiers
+    // Appends an element, overwriting the oldest one if the ring is full.
+    void push_back(const value_type& item) {
+      const std::uint64_t tail = m_header->tail;
+      if (tail - m_header->head == m_capacity) {
+        // The new element goes into the oldest one's slot, so drop it first.
+        publish_head(m_header->head + 1);
+        std::atomic_signal_fence(std::memory_order_release);
+      }
+      std::memcpy(slot_ptr(tail), &item, sizeof(value_type));
+      publish_tail(tail + 1);
+      if (m_sync_interval && tail + 1 - m_synced >= m_sync_interval) {
+        sync();
+      }
+    }
+
+    // Like CircularContainer's, the pops do nothing on an empty ring.
+    void pop_front() noexcept {
+      if (!empty()) {
+        publish_head(m_header->head + 1);
+      }
+    }
+
+    // Removes the count oldest elements (all of them if count >= size()).
+    void pop_front(size_type count) noexcept {
+      publish_head(m_header->head + (count < size() ? count : size()));
+    }
+
+    void pop_back() noexcept {
+      if (empty()) {
+        return;
+      }
+      publish_tail(m_header->tail - 1);
+      // The next push_back rewrites that slot, which may already be synced.
+      if (m_synced > m_header->tail) {
+        m_synced = m_header->tail;
+      }
+    }
+
+    // Empties the ring; positions keep counting, so sync() still knows which
+    // slots changed.
+    void clear() noexcept {
+      publish_head(m_header->tail);
+    }
+
+    // Persistence:
+    // Writes the slots pushed since the last sync() and the header to the file
+    // and waits for the writes to complete (msync with MS_SYNC).
+    void sync() {
+      const std::uint64_t tail = m_header->tail;
+      const std::uint64_t dirty = tail - m_synced < m_capacity ? tail - m_synced : m_capacity;
+      if (dirty) {
+        const std::uint64_t first = tail - dirty;
+        const size_type start = slot(first);
+        const size_type first_run = dirty < m_capacity - start ? dirty : m_capacity - start;
+        sync_range(m_slots + start, first_run * sizeof(value_type));
+        if (dirty > first_run) {
+          sync_range(m_slots, (dirty - first_run) * sizeof(value_type));
+        }
+      }
+      sync_range(m_header, sizeof(header_type));
+      m_synced = tail;
+    }
+
+    // Has push_back call sync() after every count elements; 0 (the default)
+    // leaves write-back to the kernel.
+    void set_sync_interval(size_type count) noexcept {
+      m_sync_interval = count;
+    }
+
+    [[nodiscard]] size_type sync_interval() const noexcept {
+      return m_sync_interval;
+    }
+
+    // Version the file was created with.
+    [[nodiscard]] std::uint32_t version() const noexcept {
+      return m_header->user_version;
+    }
+
+    // Capacity:
+    [[nodiscard]] size_type capacity() const noexcept {
+      return m_capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return m_header->tail == m_header->head;
+    }
+
+    [[nodiscard]] bool full() const noexcept {
+      return size() == m_capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      return static_cast<size_type>(m_header->tail - m_header->head);
+    }
+
+    // Iterators:
+    iterator begin() noexcept { return iterator(*this, m_header->head); }
+
+    iterator end() noexcept { return iterator(*this, m_header->tail); }
+
+    const_iterator begin() const noexcept { return const_iterator(*this, m_header->head); }
+
+    const_iterator end() const noexcept { return const_iterator(*this, m_header->tail); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(*this, m_header->tail - 1); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(*this, m_header->head - 1); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(*this, m_header->tail - 1); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(*this, m_header->head - 1); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Element access:
+    reference operator[](size_type pos) {
+      return *slot_ptr(m_header->head + pos);
+    }
+
+    const_reference operator[](size_type pos) const {
+      return *slot_ptr(m_header->head + pos);
+    }
+
+    reference at(size_type pos) {
+      if (pos >= size()) {
+        throw std::out_of_range("PersistentCircularContainer::at() - index out of range");
+      }
+      return (*this)[pos];
+    }
+
+    const_reference at(size_type pos) const {
+      if (pos >= size()) {
+        throw std::out_of_range("PersistentCircularContainer::at() - index out of range");
+      }
+      return (*this)[pos];
+    }
+
+    reference front() {
+      if (empty()) {
+        throw std::out_of_range("PersistentCircularContainer::front() - container is empty");
+      }
+      return *slot_ptr(m_header->head);
+    }
+
+    reference back() {
+      if (empty()) {
+        throw std::out_of_range("PersistentCircularContainer::back() - container is empty");
+      }
+      return *slot_ptr(m_header->tail - 1);
+    }
+
+    const_reference front() const {
+      if (empty()) {
+        throw std::out_of_range("PersistentCircularContainer::front() - container is empty");
+      }
+      return *slot_ptr(m_header->head);
+    }
+
+    const_reference back() const {
+      if (empty()) {
+        throw std::out_of_range("PersistentCircularContainer::back() - container is empty");
+      }
+      return *slot_ptr(m_header->tail - 1);
+    }
+
+  private:
+    friend class circular_container_iterator<PersistentCircularContainer, false>;
+    friend class circular_container_iterator<PersistentCircularContainer, true>;
+    friend class circular_container_reverse_iterator<PersistentCircularContainer, false>;
+    friend class circular_container_reverse_iterator<PersistentCircularContainer, true>;
+
+    // The iterators work on the free-running positions, so the index
+    // arithmetic is plain (wrapping) unsigned arithmetic.
+    [[nodiscard]] static size_type next_index(size_type index) noexcept {
+      return index + 1;
+    }
+
+    [[nodiscard]] static size_type prev_index(size_type index) noexcept {
+      return index - 1;
+    }
+
+    [[nodiscard]] difference_type offset_of(size_type index) const noexcept {
+      return static_cast<difference_type>(index - m_header->head);
+    }
+
+    [[nodiscard]] difference_type reverse_offset_of(size_type index) const noexcept {
+      return static_cast<difference_type>(index - (m_header->head - 1)) - 1;
+    }
+
+    [[nodiscard]] size_type index_at(difference_type offset) const noexcept {
+      return m_header->head + static_cast<size_type>(offset);
+    }
+
+    [[nodiscard]] size_type slot(std::uint64_t pos) const noexcept {
+      return static_cast<size_type>(pos % m_capacity);
+    }
+
+    [[nodiscard]] pointer slot_ptr(std::uint64_t pos) noexcept {
+      return m_slots + slot(pos);
+    }
+
+    [[nodiscard]] const_pointer slot_ptr(std::uint64_t pos) const noexcept {
+      return m_slots + slot(pos);
+    }
+
+    // The compiler must not sink slot writes below the header update that
+    // publishes them (a signal may end the process between any two stores).
+    void publish_head(std::uint64_t head) noexcept {
+      std::atomic_signal_fence(std::memory_order_release);
+      m_header->head = head;
+    }
+
+    void publish_tail(std::uint64_t tail) noexcept {
+      std::atomic_signal_fence(std::memory_order_release);
+      m_header->tail = tail;
+    }
+
+    // msync needs a page-aligned start.
+    void sync_range(const void* first, size_type bytes) const {
+      const auto address = reinterpret_cast<std::uintptr_t>(first);
+      const std::uintptr_t start = address - address % page_size();
+      if (::msync(reinterpret_cast<void*>(start), bytes + (address - start), MS_SYNC) == -1) {
+        throw std::system_error(errno, std::generic_category(), "msync");
+      }
+    }
+
+    [[nodiscard]] static size_type page_size() noexcept {
+      return static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    }
+
+    void open(const std::string& path, size_type capacity, std::uint32_t version) {
+      const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), "open");
+      }
+      try {
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+          throw std::system_error(errno, std::generic_category(), "fstat");
+        }
+        const bool created = st.st_size == 0;
+        if (created) {
+          if (capacity == 0) {
+            throw std::runtime_error("PersistentCircularContainer - " + path + " does not exist and no capacity was given");
+          }
+          m_bytes = header_bytes() + capacity * sizeof(value_type);
+          // A sparse file: the slots take disk space as they are written.
+          if (::ftruncate(fd, static_cast<off_t>(m_bytes)) == -1) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+          }
+        } else {
+          m_bytes = static_cast<size_type>(st.st_size);
+          if (m_bytes < sizeof(header_type)) {
+            throw std::runtime_error("PersistentCircularContainer - " + path + " is not a ring file");
+          }
+        }
+        void* region = ::mmap(nullptr, m_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+          throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        m_mapping = region;
+        m_header = static_cast<header_type*>(region);
+        // A file whose creation was interrupted has no magic yet and is
+        // initialized again.
+        if (created || m_header->magic == 0) {
+          initialize(capacity, version);
+        } else {
+          validate(path, capacity, version);
+        }
+        m_slots = reinterpret_cast<pointer>(static_cast<char*>(region) + m_header->data_offset);
+        m_capacity = static_cast<size_type>(m_header->capacity);
+        m_synced = m_header->tail;
+      } catch (...) {
+        unmap();
+        ::close(fd);
+        throw;
+      }
+      // The mapping keeps the file open.
+      ::close(fd);
+    }
+
+    void initialize(size_type capacity, std::uint32_t version) {
+      if (capacity == 0 || header_bytes() + capacity * sizeof(value_type) != m_bytes) {
+        throw std::runtime_error("PersistentCircularContainer - incomplete ring file does not match the capacity");
+      }
+      auto* header = ::new (static_cast<void*>(m_header)) header_type{};
+      header->format_version = header_type::file_version;
+      header->user_version = version;
+      header->type_hash = detail::persistent_type_hash<value_type>();
+      header->element_size = sizeof(value_type);
+      header->element_align = alignof(value_type);
+      header->capacity = capacity;
+      header->data_offset = header_bytes();
+      header->head = 0;
+      header->tail = 0;
+      // The magic goes last: a file without it is not a ring yet.
+      std::atomic_signal_fence(std::memory_order_release);
+      header->magic = header_type::file_magic;
+    }
+
+    void validate(const std::string& path, size_type capacity, std::uint32_t version) const {
+      const header_type& header = *m_header;
+      const auto mismatch = [&](const char* what) {
+        return std::runtime_error("PersistentCircularContainer - " + path + " " + what);
+      };
+      if (header.magic != header_type::file_magic || header.format_version != header_type::file_version) {
+        throw mismatch("is not a ring file of this format");
+      }
+      if (header.type_hash != detail::persistent_type_hash<value_type>() || header.element_size != sizeof(value_type) ||
+          header.element_align != alignof(value_type)) {
+        throw mismatch("holds a different element type");
+      }
+      if (header.user_version != version) {
+        throw mismatch("has a different version");
+      }
+      if (header.data_offset < sizeof(header_type) || header.data_offset % alignof(value_type) != 0 ||
+          header.data_offset >= m_bytes) {
+        throw mismatch("has a corrupt header");
+      }
+      if (header.capacity == 0 || (capacity != 0 && header.capacity != capacity) ||
+          header.data_offset + header.capacity * sizeof(value_type) != m_bytes) {
+        throw mismatch("has a different capacity");
+      }
+      if (header.tail - header.head > header.capacity) {
+        throw mismatch("has a corrupt header");
+      }
+    }
+
+    [[nodiscard]] static size_type header_bytes() noexcept {
+      return page_size();
+    }
+
+    void unmap() noexcept {
+      if (m_mapping) {
+        ::munmap(m_mapping, m_bytes);
+        m_mapping = nullptr;
+      }
+    }
+
+    void* m_mapping = nullptr;
+    size_type m_bytes = 0;
+    header_type* m_header = nullptr;
+    pointer m_slots = nullptr;
+    size_type m_capacity = 0;
+    size_type m_sync_interval = 0;
+    // Tail position at the last sync().
+    std::uint64_t m_synced = 0;
+};
+}
+
+#endif // __linux__
+
+#endif // PERSISTENTCIRCULARCONTAINER_H_
@@ -0,0 +1,118 @@
+#ifndef SEQLOCKCIRCULARCONTAINER_H_
+#define SEQLOCKCIRCULARCONTAINER_H_
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include "CircularContainer.hpp"
+
+namespace vfc {
+// Ring with one writer thread and any number of reader threads, where the
+// writer never waits for the readers. push_back always succeeds and
+// overwrites the oldest element when full, like CircularContainer::push_back;
+// latest(k, out) copies the k newest elements into caller storage.
+//
+// The positions work as sequence counters: before writing position p the
+// writer announces it in m_claimed, and after writing publishes p + 1 in
+// m_published. A reader copies the slots below the published position and
+// then checks m_claimed: if the writer has since started on a position that
+// reuses one of the copied slots, the copy may be torn and is retried.
+// Readers of k elements only retry when the writer gets capacity() - k pushes
+// ahead during one copy, so asking for well under capacity() elements keeps
+// them from starving.
+//
+// Readers copy slots the writer may be overwriting, as with any seqlock, so
+// Tp must be trivially copyable; a torn copy is detected and never returned.
+template<typename Tp, std::size_t _capacity>
+class SeqlockCircularContainer {
+    static_assert(_capacity > 0, "SeqlockCircularContainer needs at least one slot");
+    static_assert(std::is_trivially_copyable_v<Tp>, "readers copy elements while they may be overwritten");
+
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    SeqlockCircularContainer() = default;
+    SeqlockCircularContainer(const SeqlockCircularContainer& other) = delete;
+    SeqlockCircularContainer& operator=(const SeqlockCircularContainer& other) = delete;
+    ~SeqlockCircularContainer() = default;
+
+    // Writer (one thread):
+    // Appends an element, overwriting the oldest one if the ring is full.
+    void push_back(const value_type& item) noexcept {
+      const size_type pos = m_published.load(std::memory_order_relaxed);
+      m_claimed.store(pos + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      std::memcpy(&m_buffer[slot(pos)], &item, sizeof(value_type));
+      m_published.store(pos + 1, std::memory_order_release);
+    }
+
+    // Readers (any thread):
+    // Copies the min(count, size()) newest elements to out, oldest first, and
+    // returns their number. Retries until it gets a consistent copy.
+    size_type latest(size_type count, value_type* out) const noexcept {
+      for (;;) {
+        const size_type published = m_published.load(std::memory_order_acquire);
+        const size_type available = published < _capacity ? published : _capacity;
+        const size_type taken = count < available ? count : available;
+        if (taken == 0) {
+          return 0;
+        }
+        const size_type first = published - taken;
+        const size_type start = slot(first);
+        const size_type first_part = taken < _capacity - start ? taken : _capacity - start;
+        std::memcpy(out, &m_buffer[start], first_part * sizeof(value_type));
+        std::memcpy(out + first_part, &m_buffer[0], (taken - first_part) * sizeof(value_type));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Positions up to claimed - 1 may have been (partly) written; the
+        // one that reuses the slot of first is first + capacity().
+        if (m_claimed.load(std::memory_order_relaxed) <= first + _capacity) {
+          return taken;
+        }
+      }
+    }
+
+    // Copies the newest element to item; returns false if there is none.
+    bool back(value_type& item) const noexcept {
+      return latest(1, &item) == 1;
+    }
+
+    // Capacity (size() and empty() are only a snapshot while the writer is active):
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+      return _capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      const size_type published = m_published.load(std::memory_order_acquire);
+      return published < _capacity ? published : _capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    // Number of elements pushed so far, including the overwritten ones.
+    [[nodiscard]] size_type total_pushed() const noexcept {
+      return m_published.load(std::memory_order_acquire);
+    }
+
+  private:
+    [[nodiscard]] static constexpr size_type slot(size_type pos) noexcept {
+      if constexpr (detail::ring_layout<_capacity>::is_power_of_two) {
+        return pos & (_capacity - 1);
+      } else {
+        return pos % _capacity;
+      }
+    }
+
+    // Both counters are written by the writer only and read by every reader.
+    alignas(detail::cache_line_size) std::atomic<size_type> m_published{0};
+    std::atomic<size_type> m_claimed{0};
+    alignas(detail::cache_line_size) std::array<value_type, _capacity> m_buffer;
+};
+}
+
+#endif // SEQLOCKCIRCULARCONTAINER_H_
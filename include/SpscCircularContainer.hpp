@@ -0,0 +1,139 @@
+#ifndef SPSCCIRCULARCONTAINER_H_
+#define SPSCCIRCULARCONTAINER_H_
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "CircularContainer.hpp"
+
+namespace vfc {
+// Lock-free single-producer/single-consumer ring using the CircularContainer
+// layout. Exactly one thread may call the producer side (try_push,
+// try_emplace) and exactly one thread the consumer side (try_pop). Unlike
+// CircularContainer::push_back, a push on a full ring fails instead of
+// overwriting the oldest element. Like CircularContainer, slots are raw
+// storage: elements are constructed by the push and destroyed by the pop, so
+// Tp need not be default-constructible.
+//
+// Stats (no_stats by default, atomic_stats to enable) counts pushes, pops,
+// refused pushes and the peak size(); see stats(). Each side keeps its own
+// counters on its own cache line. The peak is taken from the producer's
+// snapshot of the head, so it can overstate the true size by what the
+// consumer popped since.
+template<typename Tp, std::size_t _capacity, typename Stats = no_stats>
+class SpscCircularContainer {
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    SpscCircularContainer() = default;
+    SpscCircularContainer(const SpscCircularContainer& other) = delete;
+    SpscCircularContainer& operator=(const SpscCircularContainer& other) = delete;
+    ~SpscCircularContainer() {
+      if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        for (size_type head = m_head.load(std::memory_order_relaxed); head != tail; head = layout::next_index(head)) {
+          slot_ptr(head)->~value_type();
+        }
+      }
+    }
+
+    // Producer side:
+    bool try_push(const value_type& item) {
+      return try_emplace(item);
+    }
+
+    bool try_push(value_type&& item) {
+      return try_emplace(std::move(item));
+    }
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+      const size_type tail = m_tail.load(std::memory_order_relaxed);
+      if (layout::distance(m_cached_head, tail) == _capacity) {
+        // Looks full from our last snapshot; refresh it from the consumer.
+        m_cached_head = m_head.load(std::memory_order_acquire);
+        if (layout::distance(m_cached_head, tail) == _capacity) {
+          if constexpr (Stats::enabled) {
+            m_producer_stats.on_reject(1);
+          }
+          return false;
+        }
+      }
+      ::new (static_cast<void*>(slot_ptr(tail))) value_type(std::forward<Args>(args)...);
+      m_tail.store(layout::next_index(tail), std::memory_order_release);
+      if constexpr (Stats::enabled) {
+        m_producer_stats.on_push(1, layout::distance(m_cached_head, tail) + 1);
+      }
+      return true;
+    }
+
+    // Consumer side:
+    bool try_pop(value_type& item) {
+      const size_type head = m_head.load(std::memory_order_relaxed);
+      if (head == m_cached_tail) {
+        // Looks empty from our last snapshot; refresh it from the producer.
+        m_cached_tail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cached_tail) {
+          return false;
+        }
+      }
+      value_type* slot = slot_ptr(head);
+      item = std::move(*slot);
+      slot->~value_type();
+      m_head.store(layout::next_index(head), std::memory_order_release);
+      if constexpr (Stats::enabled) {
+        m_consumer_stats.on_pop(1);
+      }
+      return true;
+    }
+
+    // Capacity (size() and empty() are only a snapshot when both sides are active):
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+      return _capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      const size_type head = m_head.load(std::memory_order_acquire);
+      return layout::distance(head, m_tail.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    // Snapshot of the counters kept by the stats policy (not with no_stats).
+    template<typename S = Stats>
+    [[nodiscard]] container_stats stats() const noexcept {
+      static_assert(S::enabled, "stats() needs a stats policy such as vfc::atomic_stats");
+      container_stats stats = m_producer_stats.snapshot();
+      stats.pops = m_consumer_stats.snapshot().pops;
+      return stats;
+    }
+
+  private:
+    using layout = detail::ring_layout<_capacity>;
+
+    [[nodiscard]] value_type* slot_ptr(size_type index) noexcept {
+      return m_buffer.slots + layout::slot(index);
+    }
+
+    // Producer-owned lines: its index, its snapshot of the consumer's and its
+    // counters.
+    alignas(detail::cache_line_size) std::atomic<size_type> m_tail{0};
+    size_type m_cached_head = 0;
+    Stats m_producer_stats;
+
+    // Consumer-owned lines: the same for the consumer.
+    alignas(detail::cache_line_size) std::atomic<size_type> m_head{0};
+    size_type m_cached_tail = 0;
+    Stats m_consumer_stats;
+
+    alignas(detail::cache_line_size) detail::uninitialized_array<value_type, layout::buffer_size> m_buffer;
+};
+}
+
+#endif // SPSCCIRCULARCONTAINER_H_
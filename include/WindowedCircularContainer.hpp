@@ -0,0 +1,233 @@
+#ifndef WINDOWEDCIRCULARCONTAINER_H_
+#define WINDOWEDCIRCULARCONTAINER_H_
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "CircularContainer.hpp"
+
+namespace vfc {
+// Aggregates for WindowedCircularContainer. Each one is told about every
+// element entering (on_push) and leaving (on_pop) the window, together with
+// the element's sequence number, and keeps its result up to date.
+
+// Running sum, in value_type. O(1) per element.
+template<typename Tp, std::size_t _capacity>
+class window_sum {
+  public:
+    [[nodiscard]] Tp sum() const noexcept {
+      return m_sum;
+    }
+
+  protected:
+    void on_push(const Tp& value, std::uint64_t) { m_sum += value; }
+    void on_pop(const Tp& value, std::uint64_t) { m_sum -= value; }
+    void on_clear() { m_sum = Tp(); }
+
+  private:
+    Tp m_sum = Tp();
+};
+
+// Running mean and population variance (Welford's update, reversed for
+// removals), in double. O(1) per element. A removal can cancel m2 below zero
+// when the values are nearly equal, so it is clamped there.
+template<typename Tp, std::size_t _capacity>
+class window_variance {
+  public:
+    [[nodiscard]] double mean() const noexcept {
+      return m_mean;
+    }
+
+    [[nodiscard]] double variance() const noexcept {
+      return m_count > 1 ? m_m2 / static_cast<double>(m_count) : 0.0;
+    }
+
+  protected:
+    void on_push(const Tp& value, std::uint64_t) {
+      const auto x = static_cast<double>(value);
+      ++m_count;
+      const double delta = x - m_mean;
+      m_mean += delta / static_cast<double>(m_count);
+      m_m2 += delta * (x - m_mean);
+    }
+
+    void on_pop(const Tp& value, std::uint64_t) {
+      if (--m_count == 0) {
+        on_clear();
+        return;
+      }
+      const auto x = static_cast<double>(value);
+      const double delta = x - m_mean;
+      m_mean -= delta / static_cast<double>(m_count);
+      m_m2 -= delta * (x - m_mean);
+      if (m_m2 < 0.0) {
+        m_m2 = 0.0; // rounding on nearly equal values
+      }
+    }
+
+    void on_clear() {
+      m_count = 0;
+      m_mean = 0.0;
+      m_m2 = 0.0;
+    }
+
+  private:
+    std::size_t m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;
+};
+
+namespace detail {
+// Monotonic deque of (value, sequence) candidates: the front is the extreme
+// (per Compare) of the window, and each element is pushed and popped at most
+// once, so updates are amortized O(1).
+template<typename Tp, std::size_t _capacity, typename Compare>
+class window_extreme {
+  protected:
+    [[nodiscard]] const Tp& extreme(const char* what) const {
+      if (m_candidates.empty()) {
+        throw std::out_of_range(what);
+      }
+      return m_candidates.front().first;
+    }
+
+    void on_push(const Tp& value, std::uint64_t sequence) {
+      // Candidates that value beats can never be the extreme again.
+      while (!m_candidates.empty() && !Compare()(m_candidates.back().first, value)) {
+        m_candidates.pop_back();
+      }
+      m_candidates.emplace_back(value, sequence);
+    }
+
+    void on_pop(const Tp&, std::uint64_t sequence) {
+      if (!m_candidates.empty() && m_candidates.front().second == sequence) {
+        m_candidates.pop_front();
+      }
+    }
+
+    void on_clear() {
+      m_candidates.clear();
+    }
+
+  private:
+    CircularContainer<std::pair<Tp, std::uint64_t>, _capacity> m_candidates;
+};
+} // namespace detail
+
+// Smallest element of the window; amortized O(1) per element.
+template<typename Tp, std::size_t _capacity>
+class window_min : public detail::window_extreme<Tp, _capacity, std::less<Tp>> {
+  public:
+    [[nodiscard]] const Tp& min() const {
+      return this->extreme("window_min::min() - window is empty");
+    }
+};
+
+// Largest element of the window; amortized O(1) per element.
+template<typename Tp, std::size_t _capacity>
+class window_max : public detail::window_extreme<Tp, _capacity, std::greater<Tp>> {
+  public:
+    [[nodiscard]] const Tp& max() const {
+      return this->extreme("window_max::max() - window is empty");
+    }
+};
+
+// Fixed-size sliding window over a CircularContainer that keeps the requested
+// aggregates current as push_back overwrites and pop_front removes elements,
+// instead of rescanning the window:
+//
+//   WindowedCircularContainer<double, 64, window_sum, window_variance, window_max> w;
+//   w.push_back(sample);
+//   w.sum(); w.mean(); w.variance(); w.max();
+//
+// Elements are read-only through the window so that the aggregates stay valid.
+template<typename Tp, std::size_t _capacity, template<typename, std::size_t> class... Ops>
+class WindowedCircularContainer : public Ops<Tp, _capacity>... {
+    using container_type = CircularContainer<Tp, _capacity>;
+
+  public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+    using const_reference = const value_type&;
+    using const_iterator = typename container_type::const_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+    // Modifiers
+    void push_back(const value_type& item) {
+      if (m_window.full()) {
+        retire_front();
+      }
+      m_window.push_back(item);
+      (Ops<Tp, _capacity>::on_push(m_window.back(), m_pushed), ...);
+      ++m_pushed;
+    }
+
+    void pop_front() {
+      if (!m_window.empty()) {
+        retire_front();
+        m_window.pop_front();
+      }
+    }
+
+    void clear() {
+      m_window.clear();
+      (Ops<Tp, _capacity>::on_clear(), ...);
+    }
+
+    // Capacity:
+    [[nodiscard]] constexpr size_type capacity() const noexcept {
+      return _capacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return m_window.empty();
+    }
+
+    [[nodiscard]] bool full() const noexcept {
+      return m_window.full();
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+      return m_window.size();
+    }
+
+    // Iterators:
+    const_iterator begin() const { return m_window.begin(); }
+
+    const_iterator end() const { return m_window.end(); }
+
+    const_reverse_iterator rbegin() const { return m_window.rbegin(); }
+
+    const_reverse_iterator rend() const { return m_window.rend(); }
+
+    // Element access:
+    const_reference operator[](size_type pos) const {
+      return m_window[pos];
+    }
+
+    const_reference at(size_type pos) const {
+      return m_window.at(pos);
+    }
+
+    const_reference front() const {
+      return m_window.front();
+    }
+
+    const_reference back() const {
+      return m_window.back();
+    }
+
+  private:
+    // Tells the aggregates that front() is leaving the window.
+    void retire_front() {
+      const std::uint64_t sequence = m_pushed - m_window.size();
+      (Ops<Tp, _capacity>::on_pop(m_window.front(), sequence), ...);
+    }
+
+    container_type m_window;
+    std::uint64_t m_pushed = 0;
+};
+}
+
+#endif // WINDOWEDCIRCULARCONTAINER_H_
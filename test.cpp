@@ -2,7 +2,30 @@
 #include <iostream>      // for std::cout (optional logging)
 #include <algorithm>     // for std::find_if
 #include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <memory_resource>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <numeric>
+#include <cstdio>
+#include <iterator>
+#include <functional>
+#include <sstream>
 #include "include/CircularContainer.hpp"
+#include "include/CircularAlgorithms.hpp"
+#include "include/DynamicCircularContainer.hpp"
+#include "include/SpscCircularContainer.hpp"
+#include "include/MpmcCircularContainer.hpp"
+#include "include/BlockingCircularContainer.hpp"
+#include "include/SeqlockCircularContainer.hpp"
+#include "include/MirroredCircularContainer.hpp"
+#include "include/PersistentCircularContainer.hpp"
+#include "include/WindowedCircularContainer.hpp"
 
 /**
  * A simple struct to test non-trivial objects in CircularContainer.
@@ -22,6 +45,43 @@ struct Person {
     }
 };
 
+/**
+ * Counts live instances to check that the container constructs and destroys
+ * exactly the elements it holds. Deliberately not default-constructible.
+ */
+struct Tracked {
+    static inline int live = 0;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked &other) : value(other.value) { ++live; }
+    Tracked(Tracked &&other) noexcept : value(other.value) { ++live; }
+    Tracked &operator=(const Tracked &other) = default;
+    Tracked &operator=(Tracked &&other) noexcept = default;
+    ~Tracked() { --live; }
+};
+
+/**
+ * Counts copies and moves, to check that an operation makes no extra ones.
+ */
+struct CopyCounted {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value = 0;
+
+    CopyCounted() = default;
+    explicit CopyCounted(int v) : value(v) {}
+    CopyCounted(const CopyCounted &other) : value(other.value) { ++copies; }
+    CopyCounted(CopyCounted &&other) noexcept : value(other.value) { ++moves; }
+    CopyCounted &operator=(const CopyCounted &other) { value = other.value; ++copies; return *this; }
+    CopyCounted &operator=(CopyCounted &&other) noexcept { value = other.value; ++moves; return *this; }
+};
+
+#if defined(__cpp_constinit) && defined(__cpp_lib_constexpr_dynamic_alloc)
+// Must be constant-initialized: a static ring needs no dynamic initializer.
+constinit vfc::CircularContainer<int, 16> static_ring;
+#endif
+
 int main()
 {
     using namespace vfc;
@@ -332,13 +392,73 @@ int main()
 
     {
         // Test std::sort with iterators
-//        CircularContainer<int, 5> c;
-//        c.push_back(3);
-//        c.push_back(1);
-//        c.push_back(2);
-//        std::sort(c.begin(), c.end());
-//        assert(c.front() == 1);
-//        assert(c.back() == 3);
+        CircularContainer<int, 5> c;
+        c.push_back(3);
+        c.push_back(1);
+        c.push_back(2);
+        std::sort(c.begin(), c.end());
+        assert(c.front() == 1);
+        assert(c.back() == 3);
+    }
+
+    {
+        // Test random-access iterators on a wrapped ring
+        CircularContainer<int, 5> c;
+        for (int v : {7, 9, 1, 8, 3, 6, 2}) {
+            c.push_back(v);
+        }
+        // c: [1,8,3,6,2], wrapping around the end of the buffer
+        assert(c.end() - c.begin() == 5);
+        assert(std::distance(c.begin(), c.end()) == 5);
+        assert(c.begin()[2] == 3 && *(c.begin() + 4) == 2 && *(c.end() - 1) == 2);
+        assert(c.begin() < c.end() && c.end() > c.begin() + 4 && c.begin() <= c.begin());
+        auto it = c.end();
+        it -= 5;
+        assert(it == c.begin());
+        assert(c[1] == 8 && c.at(3) == 6);
+        try {
+            c.at(5);
+            assert(false && "at() past size() should throw!");
+        } catch (const std::out_of_range& e) {
+            // Expected behavior
+        }
+
+        std::sort(c.begin(), c.end());
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{1, 2, 3, 6, 8}));
+        assert(*std::lower_bound(c.begin(), c.end(), 5) == 6);
+        assert(std::lower_bound(c.begin(), c.end(), 9) == c.end());
+
+        // Reverse iterators
+        assert(c.rend() - c.rbegin() == 5);
+        assert(c.rbegin()[1] == 6 && *(c.rend() - 1) == 1);
+        assert(c.rbegin() < c.rend());
+        std::sort(c.rbegin(), c.rend());
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{8, 6, 3, 2, 1}));
+
+        const auto& cc = c;
+        assert(cc.cend() - cc.cbegin() == 5 && cc.cbegin()[4] == 1 && cc[0] == 8);
+
+        CircularContainer<int, 8> p;
+        for (int i = 20; i > 0; --i) {
+            p.push_back(i);
+        }
+        std::sort(p.begin(), p.end());
+        assert((std::vector<int>(p.begin(), p.end()) == std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}));
+        assert(p.rend() - p.rbegin() == 8 && p.crbegin()[7] == 1);
+    }
+
+    {
+        // Iterators are trivially copyable two-word types
+        using Ring = CircularContainer<int, 5>;
+        static_assert(std::is_trivially_copyable_v<Ring::iterator>);
+        static_assert(std::is_trivially_copyable_v<Ring::const_reverse_iterator>);
+        static_assert(sizeof(Ring::iterator) == 2 * sizeof(void*));
+        static_assert(sizeof(Ring::reverse_iterator) == 2 * sizeof(void*));
+
+        Ring c{1, 2, 3};
+        const auto it = c.begin();
+        *it = 10; // dereferencing a const iterator still yields a mutable element
+        assert(c.front() == 10 && it[0] == 10);
     }
 
     {
@@ -365,6 +485,1357 @@ int main()
         assert(v[1] == 2);
         assert(v[2] == 3);
     }
+    {
+        // Test power-of-two capacity (mask indexing, no spare slot) across many wraps
+        CircularContainer<int, 4> c;
+        for (int i = 1; i <= 11; ++i) {
+            c.push_back(i);
+        }
+        assert(c.size() == 4 && c.full());
+        assert(c.front() == 8);
+        assert(c.back() == 11);
+        std::vector<int> v(c.begin(), c.end());
+        assert((v == std::vector<int>{8, 9, 10, 11}));
+        std::vector<int> r(c.rbegin(), c.rend());
+        assert((r == std::vector<int>{11, 10, 9, 8}));
+
+        // Inserting into a full ring drops the back element
+        c.insert(++c.begin(), 99);
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{8, 99, 9, 10}));
+
+        c.pop_front();
+        c.pop_front();
+        assert(c.size() == 2 && c.front() == 9);
+        c.push_back(12);
+        c.push_back(13);
+        c.push_back(14);
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{10, 12, 13, 14}));
+    }
+
+    {
+        // Test bulk push_back(first, last), pop_front(n) and read_into
+        CircularContainer<int, 5> c;
+        std::vector<int> in{1, 2, 3};
+        c.push_back(in.begin(), in.end());
+        assert(c.size() == 3 && c.front() == 1 && c.back() == 3);
+
+        // The batch does not fit: the oldest elements are dropped
+        std::vector<int> more{4, 5, 6, 7};
+        c.push_back(more.begin(), more.end());
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{3, 4, 5, 6, 7}));
+
+        // A batch longer than the capacity keeps only its tail
+        std::vector<int> many{10, 11, 12, 13, 14, 15, 16};
+        c.push_back(many.begin(), many.end());
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{12, 13, 14, 15, 16}));
+
+        c.pop_front(2);
+        assert(c.size() == 3 && c.front() == 14);
+        c.push_back(more.begin(), more.begin() + 2); // wraps around the buffer end
+        std::vector<int> out(4);
+        assert(c.read_into(out.begin(), 4) == 4);
+        assert((out == std::vector<int>{14, 15, 16, 4}));
+        assert(c.size() == 1 && c.front() == 5);
+        assert(c.read_into(out.begin(), 10) == 1 && out[0] == 5);
+        assert(c.empty());
+        c.pop_front(3);
+        assert(c.empty());
+#ifdef __cpp_lib_span
+        c.push_back(std::span<const int>(many));
+        assert(c.front() == 12 && c.back() == 16);
+#endif
+    }
+
+    {
+        // Test bulk operations on a power-of-two capacity after many wraps
+        CircularContainer<int, 8> c;
+        std::vector<int> expected;
+        for (int round = 0; round < 20; ++round) {
+            std::vector<int> batch;
+            for (int i = 0; i < round % 7 + 1; ++i) {
+                batch.push_back(round * 10 + i);
+            }
+            c.push_back(batch.begin(), batch.end());
+            expected.insert(expected.end(), batch.begin(), batch.end());
+            if (expected.size() > 8) {
+                expected.erase(expected.begin(), expected.end() - 8);
+            }
+            assert((std::vector<int>(c.begin(), c.end()) == expected));
+            if (round % 3 == 0) {
+                std::vector<int> out;
+                const auto n = c.read_into(std::back_inserter(out), 3);
+                assert(n == std::min<std::size_t>(3, expected.size()));
+                assert((out == std::vector<int>(expected.begin(), expected.begin() + n)));
+                expected.erase(expected.begin(), expected.begin() + n);
+            }
+        }
+    }
+
+    {
+        // Test array_one()/array_two() views and linearize()
+        CircularContainer<int, 5> c{1, 2, 3, 4, 5};
+        assert(c.is_linearized());
+        assert(c.array_one().second == 5 && c.array_two().second == 0);
+        c.push_back(6);
+        c.push_back(7);
+        // [3,4,5,6,7] now wraps around the end of the buffer
+        const auto one = c.array_one();
+        const auto two = c.array_two();
+        assert(one.second + two.second == 5);
+        std::vector<int> joined(one.first, one.first + one.second);
+        joined.insert(joined.end(), two.first, two.first + two.second);
+        assert((joined == std::vector<int>{3, 4, 5, 6, 7}));
+        assert(!c.is_linearized());
+
+        int* data = c.linearize();
+        assert(c.is_linearized() && c.array_two().second == 0);
+        assert((std::vector<int>(data, data + c.size()) == std::vector<int>{3, 4, 5, 6, 7}));
+        c.push_back(8);
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{4, 5, 6, 7, 8}));
+#ifdef __cpp_lib_span
+        const auto [first, second] = std::as_const(c).segments();
+        assert(first.size() + second.size() == 5 && first.front() == 4);
+#endif
+
+        CircularContainer<int, 4> p;
+        for (int i = 0; i < 6; ++i) {
+            p.push_back(i);
+        }
+        assert(!p.is_linearized());
+        int* pd = p.linearize();
+        assert((std::vector<int>(pd, pd + 4) == std::vector<int>{2, 3, 4, 5}));
+        assert((std::vector<int>(p.begin(), p.end()) == std::vector<int>{2, 3, 4, 5}));
+    }
+
+    {
+        // Test element lifetimes with uninitialized storage
+        {
+            CircularContainer<Tracked, 3> c;
+            assert(Tracked::live == 0); // nothing constructed up front
+            c.push_back(Tracked(1));
+            c.push_back(Tracked(2));
+            assert(Tracked::live == 2);
+            c.pop_front();
+            assert(Tracked::live == 1); // popped elements are destroyed right away
+            for (int i = 3; i <= 7; ++i) {
+                c.push_back(Tracked(i));
+            }
+            assert(Tracked::live == 3 && c.front().value == 5);
+            c.insert(c.begin() + 1, Tracked(42));
+            assert(Tracked::live == 3 && c[1].value == 42 && c.back().value == 6);
+            c.pop_front();
+            c.insert(c.begin(), Tracked(0));
+            assert(Tracked::live == 3 && c.front().value == 0);
+
+            CircularContainer<Tracked, 3> copy(c);
+            assert(Tracked::live == 6 && copy.back().value == 6);
+            copy = c;
+            assert(Tracked::live == 6);
+            CircularContainer<Tracked, 3> moved(std::move(copy));
+            assert(moved.front().value == 0);
+            c.clear();
+            assert(Tracked::live == 6);
+
+            std::vector<Tracked> batch{Tracked(8), Tracked(9), Tracked(10), Tracked(11)};
+            moved.push_back(batch.begin(), batch.end());
+            assert(moved.front().value == 9 && Tracked::live == 10);
+            moved.pop_front(2);
+            assert(Tracked::live == 8);
+        }
+        assert(Tracked::live == 0);
+
+        {
+            CircularContainer<Tracked, 4> c;
+            for (int i = 0; i < 6; ++i) {
+                c.push_back(Tracked(i));
+            }
+            assert(Tracked::live == 4);
+            c.pop_front();
+            c.push_back(Tracked(6));
+            c.pop_front();
+            const Tracked* data = c.linearize();
+            assert(data[0].value == 4 && data[2].value == 6 && Tracked::live == 3);
+        }
+        assert(Tracked::live == 0);
+
+        // Move-only elements
+        CircularContainer<std::unique_ptr<int>, 2> ptrs;
+        ptrs.emplace_back(std::make_unique<int>(1));
+        ptrs.emplace_back(std::make_unique<int>(2));
+        ptrs.emplace_back(std::make_unique<int>(3));
+        assert(ptrs.size() == 2 && *ptrs.front() == 2 && *ptrs.back() == 3);
+        CircularContainer<std::unique_ptr<int>, 2> ptrs2(std::move(ptrs));
+        assert(*ptrs2.front() == 2);
+        ptrs2.push_back(std::make_unique<int>(4)); // push_back of an rvalue moves it in
+        assert(*ptrs2.front() == 3 && *ptrs2.back() == 4);
+        static_assert(std::is_void_v<decltype(ptrs2.push_back(std::make_unique<int>(5)))>);
+
+        // push_back copies (or moves) each element exactly once, also when it
+        // overwrites, for both the power-of-two and the general layout
+        CircularContainer<CopyCounted, 4> counted4;
+        CircularContainer<CopyCounted, 3> counted3;
+        const CopyCounted item(7);
+        for (int i = 0; i < 6; ++i) {
+            counted4.push_back(item);
+            counted3.push_back(item);
+            counted4.push_back(CopyCounted(i));
+            counted3.push_back(CopyCounted(i));
+        }
+        assert(CopyCounted::copies == 12 && CopyCounted::moves == 12);
+        assert(counted4.back().value == 5 && counted3.back().value == 5);
+    }
+
+    {
+        // Test in-place emplace_back / emplace_front / emplace
+        CircularContainer<std::pair<std::string, int>, 3> c;
+        auto& first = c.emplace_back("one", 1);
+        assert(first.first == "one" && &first == &c.back());
+        c.emplace_back(std::piecewise_construct, std::forward_as_tuple(3, 'x'), std::forward_as_tuple(2));
+        assert(c.back().first == "xxx" && c.back().second == 2);
+        c.emplace_back("three", 3);
+        c.emplace_back("four", 4); // full: "one" is dropped
+        assert(c.size() == 3 && c.front().first == "xxx");
+
+        auto& zero = c.emplace_front("zero", 0); // full: the back ("four") is dropped
+        assert(&zero == &c.front() && zero.second == 0);
+        assert(c.size() == 3 && c.back().first == "three");
+
+        c.pop_front();
+        auto it = c.emplace(c.begin() + 1, "mid", 5);
+        assert(it->first == "mid" && c[1].second == 5 && c.size() == 3);
+        assert(c.emplace(c.end(), "dropped", 9) == c.end()); // full: nothing to insert at end()
+
+        // Near the front the head side is shifted; the result still points at
+        // the new element
+        CircularContainer<char, 8> letters{'a', 'b', 'c', 'd', 'e'};
+        auto x = letters.emplace(letters.begin() + 1, 'X');
+        assert(*x == 'X' && x - letters.begin() == 1 && letters[1] == 'X' && letters[2] == 'b');
+        auto y = letters.emplace(letters.begin() + 5, 'Y');
+        assert(*y == 'Y' && y - letters.begin() == 5 && letters.back() == 'e');
+
+        {
+            CircularContainer<Tracked, 4> t;
+            for (int i = 0; i < 9; ++i) {
+                assert(t.emplace_back(i).value == i);
+            }
+            assert(Tracked::live == 4 && t.front().value == 5);
+            t.emplace_front(-1);
+            assert(Tracked::live == 4 && t.front().value == -1 && t.back().value == 7);
+            t.pop_front();
+            t.emplace(t.begin() + 1, 100);
+            assert(Tracked::live == 4 && t[1].value == 100);
+            t.clear();
+            t.emplace_front(1);
+            t.emplace_front(0);
+            assert((t.front().value == 0 && t.back().value == 1 && t.size() == 2));
+        }
+        assert(Tracked::live == 0);
+    }
+
+    {
+        // Test insert/erase shifting the shorter side, checked against a vector
+        auto check = [](auto& c, std::size_t capacity) {
+            std::vector<int> model;
+            unsigned seed = 7;
+            auto next = [&seed](unsigned bound) {
+                seed = seed * 1103515245u + 12345u;
+                return (seed >> 16) % bound;
+            };
+            for (int step = 0; step < 3000; ++step) {
+                const auto at = static_cast<std::ptrdiff_t>(next(static_cast<unsigned>(model.size()) + 1));
+                switch (next(6)) {
+                case 0:
+                    c.push_back(Tracked(step));
+                    model.push_back(step);
+                    if (model.size() > capacity) {
+                        model.erase(model.begin());
+                    }
+                    break;
+                case 1: {
+                    auto it = c.insert(c.begin() + at, Tracked(step));
+                    if (static_cast<std::size_t>(at) < capacity) {
+                        assert(it->value == step);
+                        model.insert(model.begin() + at, step);
+                        model.resize(std::min(model.size(), capacity));
+                    } else {
+                        assert(it == c.end());
+                    }
+                    break;
+                }
+                case 2: {
+                    std::vector<Tracked> range;
+                    for (unsigned i = 0, n = next(5); i < n; ++i) {
+                        range.emplace_back(step * 10 + static_cast<int>(i));
+                    }
+                    auto it = c.insert(c.begin() + at, range.begin(), range.end());
+                    for (const auto& item : range) {
+                        if (static_cast<std::size_t>(at) + (&item - range.data()) < capacity) {
+                            model.insert(model.begin() + at + (&item - range.data()), item.value);
+                        }
+                    }
+                    model.resize(std::min(model.size(), capacity));
+                    assert(range.empty() || it == c.end() || it->value == range.front().value);
+                    break;
+                }
+                case 3:
+                    if (static_cast<std::size_t>(at) < model.size()) {
+                        auto it = c.erase(c.begin() + at);
+                        model.erase(model.begin() + at);
+                        assert(it - c.begin() == at);
+                    }
+                    break;
+                case 4: {
+                    const auto count = std::min<std::ptrdiff_t>(next(4), static_cast<std::ptrdiff_t>(model.size()) - at);
+                    c.erase(c.begin() + at, c.begin() + at + count);
+                    model.erase(model.begin() + at, model.begin() + at + count);
+                    break;
+                }
+                default:
+                    if (!model.empty()) {
+                        c.pop_front();
+                        model.erase(model.begin());
+                    }
+                }
+                assert(c.size() == model.size());
+                assert(Tracked::live == static_cast<int>(model.size()));
+                assert(std::equal(c.begin(), c.end(), model.begin(),
+                                  [](const Tracked& a, int b) { return a.value == b; }));
+                assert(std::equal(c.rbegin(), c.rend(), model.rbegin(),
+                                  [](const Tracked& a, int b) { return a.value == b; }));
+            }
+            c.clear();
+        };
+        CircularContainer<Tracked, 7> odd;
+        check(odd, 7);
+        CircularContainer<Tracked, 8> even; // 8-bit counters wrap many times
+        check(even, 8);
+        CircularContainer<Tracked, 128> half_range;
+        check(half_range, 128);
+        CircularContainer<Tracked, 255> full_range; // indices use all of uint8_t
+        check(full_range, 255);
+        DynamicCircularContainer<Tracked> dynamic(9);
+        check(dynamic, 9);
+        assert(Tracked::live == 0);
+
+        CircularContainer<int, 6> c{1, 2, 3, 4};
+        const int items[] = {7, 8, 9};
+        auto it = c.insert(c.begin() + 1, items, items + 3); // full: 4 is dropped
+        assert(*it == 7 && (std::vector<int>(c.begin(), c.end()) == std::vector<int>{1, 7, 8, 9, 2, 3}));
+        it = c.erase(c.begin() + 1, c.begin() + 4);
+        assert(*it == 2 && (std::vector<int>(c.begin(), c.end()) == std::vector<int>{1, 2, 3}));
+        c.insert(c.begin(), c.back()); // the inserted value may alias an element
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{3, 1, 2, 3}));
+    }
+
+    {
+        // Test the compact bookkeeping: head, tail and size are stored in the
+        // smallest type that holds the capacity
+        static_assert(sizeof(CircularContainer<std::uint8_t, 16>) == 16 + 3 * sizeof(std::uint8_t));
+        static_assert(sizeof(CircularContainer<std::uint8_t, 255>) == 256 + 3 * sizeof(std::uint8_t));
+        static_assert(sizeof(CircularContainer<std::uint8_t, 256>) == 256 + 3 * sizeof(std::uint16_t));
+        static_assert(sizeof(CircularContainer<int, 1000>) == 1001 * sizeof(int) + 3 * sizeof(std::uint16_t) + 2);
+        static_assert(sizeof(CircularContainer<char, 70000>) == 70001 + 3 + 3 * sizeof(std::uint32_t));
+        static_assert(sizeof(CircularContainer<std::uint8_t, 16, reject_when_full>) == 19);
+
+        // Counters of a power-of-two ring wrap in their own type; size(),
+        // iterators and the two runs stay consistent across the wrap.
+        CircularContainer<std::uint8_t, 128> c;
+        std::vector<std::uint8_t> model;
+        for (int i = 0; i < 1000; ++i) {
+            c.push_back(static_cast<std::uint8_t>(i));
+            model.push_back(static_cast<std::uint8_t>(i));
+            if (model.size() > 128) {
+                model.erase(model.begin());
+            }
+            if (i % 3 == 0) {
+                c.pop_front();
+                model.erase(model.begin());
+            }
+            assert(c.size() == model.size() && std::equal(c.begin(), c.end(), model.begin()));
+            assert(static_cast<std::size_t>(c.end() - c.begin()) == c.size());
+            assert(c.array_one().second + c.array_two().second == c.size());
+        }
+        c.push_back(0);
+        assert(c.full() && c.back() == 0 && c.front() == model.front());
+        assert(*(c.begin() + 127) == c.back() && *(c.rend() - 1) == c.front());
+    }
+
+    {
+        // Test the cache-aligned layout: buffer, head and tail on lines of
+        // their own, and whole lines per container
+        using Aligned = CircularContainer<int, 16, overwrite_oldest, cache_aligned_layout>;
+        static_assert(alignof(Aligned) == 64 && sizeof(Aligned) == 3 * 64);
+        static_assert(sizeof(CircularContainer<int, 16, overwrite_oldest, compact_layout>) ==
+                      sizeof(CircularContainer<int, 16>));
+
+        std::vector<Aligned> rings(3);
+        for (int i = 0; i < 20; ++i) {
+            rings[static_cast<std::size_t>(i) % 3].push_back(i);
+        }
+        for (auto& ring : rings) {
+            assert(reinterpret_cast<std::uintptr_t>(ring.array_one().first) % 64 == 0);
+        }
+        assert((std::vector<int>(rings[0].begin(), rings[0].end()) == std::vector<int>{0, 3, 6, 9, 12, 15, 18}));
+        rings[1].pop_front();
+        assert(rings[1].front() == 4 && rings[1].size() == 6);
+        Aligned copy = rings[2];
+        assert(std::equal(copy.begin(), copy.end(), rings[2].begin(), rings[2].end()));
+    }
+
+    {
+        // Test push_front / pop_back and the front overflow policies
+        CircularContainer<int, 4> c;
+        c.push_front(2);
+        c.push_front(1);
+        c.push_back(3);
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{1, 2, 3}));
+        c.pop_back();
+        assert(c.back() == 2 && c.size() == 2);
+        c.push_back(3);
+        c.push_back(4);
+        c.push_front(0); // full: the newest element (4) is dropped
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{0, 1, 2, 3}));
+        c.push_front<front_overflow::overwrite_oldest>(-1); // full: front() is replaced
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{-1, 1, 2, 3}));
+        c.pop_back(2);
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{-1, 1}));
+        c.pop_back(5);
+        assert(c.empty());
+        c.pop_back(); // no-op when empty
+        assert(c.empty());
+
+        // Pushing one of its own elements onto a full ring copies it before
+        // anything is dropped
+        CircularContainer<std::string, 4> words{"alpha", "beta", "gamma", "delta"};
+        words.push_front(words.back());
+        assert((std::vector<std::string>(words.begin(), words.end()) ==
+                std::vector<std::string>{"delta", "alpha", "beta", "gamma"}));
+        words.push_front(words.front());
+        assert(words.front() == "delta" && words[1] == "delta" && words.back() == "beta");
+        words.push_front<front_overflow::overwrite_oldest>(words.front());
+        assert(words.front() == "delta" && words.size() == 4 && words.back() == "beta");
+        words.push_front<front_overflow::overwrite_oldest>(words.back());
+        assert((std::vector<std::string>(words.begin(), words.end()) ==
+                std::vector<std::string>{"beta", "delta", "alpha", "beta"}));
+        CircularContainer<std::string, 3> odd{"x", "y", "z"};
+        odd.emplace_front(odd.back());
+        assert(odd.front() == "z" && odd.back() == "y");
+        odd.emplace_front<front_overflow::overwrite_oldest>(odd.back());
+        assert(odd.front() == "y" && odd[1] == "x" && odd.back() == "y");
+
+        // Used as a bounded deque across many wraps of an odd-sized ring
+        CircularContainer<Tracked, 5> d;
+        std::vector<int> model;
+        for (int i = 0; i < 200; ++i) {
+            if (i % 3 == 0) {
+                d.emplace_front(i);
+                model.insert(model.begin(), i);
+                model.resize(std::min<std::size_t>(model.size(), 5));
+            } else if (i % 7 == 0) {
+                d.pop_back();
+                model.pop_back();
+            } else {
+                d.emplace_front<front_overflow::overwrite_oldest>(i);
+                if (model.size() == 5) {
+                    model.front() = i;
+                } else {
+                    model.insert(model.begin(), i);
+                }
+            }
+            assert(Tracked::live == static_cast<int>(model.size()));
+            assert(std::equal(d.begin(), d.end(), model.begin(),
+                              [](const Tracked& a, int b) { return a.value == b; }));
+        }
+    }
+    assert(Tracked::live == 0);
+
+    {
+        // Test overflow policies
+        static_assert(sizeof(CircularContainer<int, 8, reject_when_full>) == sizeof(CircularContainer<int, 8>));
+
+        CircularContainer<int, 3, reject_when_full> queue;
+        assert(queue.push_back(1) && queue.push_back(2) && queue.emplace_back(3));
+        assert(!queue.push_back(4) && !queue.emplace_back(5)); // full: rejected, nothing dropped
+        assert((std::vector<int>(queue.begin(), queue.end()) == std::vector<int>{1, 2, 3}));
+        queue.pop_front();
+        const int batch[] = {6, 7, 8};
+        assert(queue.push_back(batch, batch + 3) == 1); // only the leading element fits
+        assert((std::vector<int>(queue.begin(), queue.end()) == std::vector<int>{2, 3, 6}));
+
+        std::vector<int> spilled;
+        auto spill = [&spilled](Tracked&& evicted) { spilled.push_back(evicted.value); };
+        {
+            CircularContainer<Tracked, 4, evict_to<decltype(spill)>> c(evict_to{spill});
+            for (int i = 0; i < 7; ++i) {
+                c.emplace_back(i);
+            }
+            assert((spilled == std::vector<int>{0, 1, 2}));
+            assert(Tracked::live == 4 && c.front().value == 3);
+            const std::vector<Tracked> more{Tracked(7), Tracked(8)};
+            c.push_back(more.begin(), more.end());
+            assert((spilled == std::vector<int>{0, 1, 2, 3, 4}) && c.back().value == 8);
+
+            CircularContainer<Tracked, 3, evict_to<decltype(spill)>> odd(evict_to{spill});
+            spilled.clear();
+            for (int i = 0; i < 5; ++i) {
+                odd.push_back(Tracked(i));
+            }
+            assert((spilled == std::vector<int>{0, 1}) && odd.front().value == 2);
+        }
+        assert(Tracked::live == 0);
+
+        // The new element is built before the oldest one is handed over, so it
+        // can be a copy of front()
+        std::vector<std::string> spilled_words;
+        auto spill_word = [&spilled_words](std::string&& evicted) { spilled_words.push_back(std::move(evicted)); };
+        CircularContainer<std::string, 2, evict_to<decltype(spill_word)>> words(evict_to{spill_word});
+        CircularContainer<std::string, 3, evict_to<decltype(spill_word)>> odd_words(evict_to{spill_word});
+        const std::string first(30, 'f');
+        const std::string second(30, 's');
+        for (const std::string& word : {first, second, second}) {
+            words.push_back(word);
+            odd_words.push_back(word);
+        }
+        words.push_back(words.front());
+        odd_words.push_back(odd_words.front());
+        assert(words.back() == second && odd_words.back() == first);
+        assert((spilled_words == std::vector<std::string>{first, second, first}));
+
+        // push_front, insert and emplace hand what they drop to the callback too
+        {
+            CircularContainer<Tracked, 4, evict_to<decltype(spill)>> c(evict_to{spill});
+            for (int i = 0; i < 4; ++i) {
+                c.emplace_back(i);
+            }
+            spilled.clear();
+            c.push_front(Tracked(10)); // drops the back (3)
+            c.emplace_front<front_overflow::overwrite_oldest>(11); // drops the front (10)
+            c.insert(c.begin() + 1, Tracked(12)); // drops the back (2)
+            c.emplace(c.begin() + 2, 13); // drops the back (1)
+            const Tracked pair[] = {Tracked(14), Tracked(15)};
+            c.insert(c.begin() + 1, pair, pair + 2); // drops the back two (13, 0)
+            assert((spilled == std::vector<int>{3, 10, 2, 1, 13, 0}));
+            assert(c.front().value == 11 && c[1].value == 14 && c[2].value == 15 && c.back().value == 12);
+        }
+        assert(Tracked::live == 0);
+
+        DynamicCircularContainer<int, std::allocator<int>, reject_when_full> dynamic(2);
+        assert(dynamic.push_back(1) && dynamic.push_back(2) && !dynamic.push_back(3));
+    }
+
+    {
+        // Test stats policies: counters for pushes, pops, overwrites, rejects,
+        // insert/erase shifts and the peak size; no_stats adds nothing
+        static_assert(sizeof(CircularContainer<int, 8, overwrite_oldest, compact_layout, no_stats>) ==
+                      sizeof(CircularContainer<int, 8>));
+
+        CircularContainer<int, 4, overwrite_oldest, compact_layout, count_stats> c;
+        for (int i = 0; i < 6; ++i) {
+            c.push_back(i); // the last two overwrite 0 and 1
+        }
+        c.pop_front();
+        c.pop_back();
+        container_stats stats = c.stats();
+        assert(stats.pushes == 6 && stats.overwrites == 2 && stats.pops == 2);
+        assert(stats.peak_size == 4 && stats.rejected == 0);
+
+        c.insert(c.begin() + 1, 10); // {3, 10, 4}: shifts the one element before it
+        c.push_front(11);            // full afterwards
+        c.push_front(12);            // drops the back element
+        stats = c.stats();
+        assert(stats.pushes == 9 && stats.overwrites == 3 && stats.shifted == 1 && stats.max_shift == 1);
+        assert((std::vector<int>(c.begin(), c.end()) == std::vector<int>{12, 11, 3, 10}));
+        c.erase(c.begin() + 2);
+        const int batch[] = {20, 21, 22, 23, 24};
+        c.push_back(batch, batch + 5); // counted as five push_backs, four of which overwrite
+        stats = c.stats();
+        assert(stats.pushes == 14 && stats.overwrites == 7 && stats.pops == 3 && stats.shifted == 2);
+
+        auto copy = c;
+        assert(copy.stats().pushes == 14);
+        c.reset_stats();
+        assert(c.stats().pushes == 0 && c.stats().peak_size == 0 && copy.stats().pops == 3);
+
+        CircularContainer<int, 2, reject_when_full, compact_layout, count_stats> bounded;
+        assert(bounded.push_back(1) && bounded.push_back(2) && !bounded.push_back(3));
+        assert(bounded.push_back(batch, batch + 5) == 0);
+        assert(bounded.stats().rejected == 6 && bounded.stats().pushes == 2);
+        // An input range is left unread after the first element that does not fit
+        std::istringstream numbers("1 2 3 4 5");
+        std::istream_iterator<int> in(numbers);
+        bounded.clear();
+        bounded.reset_stats();
+        assert(bounded.push_back(in, std::istream_iterator<int>()) == 2);
+        assert(bounded.stats().rejected == 1 && bounded.stats().pushes == 2);
+        int unread = 0;
+        assert(numbers >> unread && unread == 4);
+
+        MpmcCircularContainer<int, 2, atomic_stats> mpmc;
+        assert(mpmc.try_push(1) && mpmc.try_push(2) && !mpmc.try_push(3));
+        mpmc.push_back(4);
+        int out = 0;
+        assert(mpmc.try_pop(out) && out == 2);
+        stats = mpmc.stats();
+        assert(stats.pushes == 3 && stats.rejected == 1 && stats.overwrites == 1 && stats.pops == 1);
+        assert(stats.peak_size == 2);
+
+        SpscCircularContainer<int, 2, atomic_stats> spsc;
+        assert(spsc.try_push(1) && spsc.try_push(2) && !spsc.try_push(3));
+        assert(spsc.try_pop(out) && spsc.stats().pops == 1 && spsc.stats().rejected == 1);
+        assert(spsc.stats().peak_size == 2);
+    }
+
+    {
+        // Test copy, move and swap: only live elements are transferred, and
+        // the copy is linearized from the first slot
+        CircularContainer<int, 8> c;
+        for (int i = 0; i < 11; ++i) {
+            c.push_back(i);
+        }
+        c.pop_front();
+        assert(!c.is_linearized());
+        CircularContainer<int, 8> copy(c);
+        assert(copy.is_linearized() && copy.array_one().second == 7);
+        assert(std::equal(copy.begin(), copy.end(), c.begin(), c.end()));
+        copy.push_back(11);
+        copy.push_back(12); // the copy still wraps correctly when full
+        assert(copy.full() && copy.front() == 5 && copy.back() == 12);
+
+        CircularContainer<int, 8> moved(std::move(copy));
+        assert(moved.size() == 8 && moved.front() == 5 && moved.is_linearized());
+        moved = c;
+        assert(std::equal(moved.begin(), moved.end(), c.begin(), c.end()));
+
+        CircularContainer<int, 8> few{1, 2};
+        static_assert(noexcept(few.swap(c)));
+        few.swap(c);
+        assert(c.size() == 2 && c.front() == 1 && few.size() == 7 && few.front() == 4 && few.back() == 10);
+        swap(few, c);
+        assert(few.size() == 2 && c.size() == 7 && c.back() == 10);
+
+        {
+            CircularContainer<Tracked, 5> a;
+            CircularContainer<Tracked, 5> b;
+            for (int i = 0; i < 7; ++i) {
+                a.emplace_back(i);
+            }
+            b.emplace_back(100);
+            a.swap(b);
+            assert(Tracked::live == 6 && a.size() == 1 && a.front().value == 100);
+            assert(b.size() == 5 && b.front().value == 2 && b.back().value == 6);
+            CircularContainer<Tracked, 5> copied(b);
+            assert(Tracked::live == 11 && copied.is_linearized() && copied.back().value == 6);
+        }
+        assert(Tracked::live == 0);
+
+        {
+            // Swapping needs no stack space for a temporary of the full capacity
+            auto big_a = std::make_unique<CircularContainer<int, 1 << 22>>();
+            auto big_b = std::make_unique<CircularContainer<int, 1 << 22>>();
+            for (int i = 0; i < 100; ++i) {
+                big_a->push_back(i);
+            }
+            big_a->pop_front(40);
+            big_b->push_back(-1);
+            big_a->swap(*big_b);
+            assert(big_a->size() == 1 && big_a->front() == -1);
+            assert(big_b->size() == 60 && big_b->front() == 40 && big_b->back() == 99);
+
+            // Both sides wrap, with different head positions
+            CircularContainer<std::string, 6> left;
+            CircularContainer<std::string, 6> right;
+            for (int i = 0; i < 9; ++i) {
+                left.push_back(std::string(30, static_cast<char>('a' + i)));
+            }
+            for (int i = 0; i < 4; ++i) {
+                right.push_back(std::to_string(i));
+            }
+            const std::vector<std::string> left_items(left.begin(), left.end());
+            const std::vector<std::string> right_items(right.begin(), right.end());
+            left.swap(right);
+            assert(std::equal(left.begin(), left.end(), right_items.begin(), right_items.end()));
+            assert(std::equal(right.begin(), right.end(), left_items.begin(), left_items.end()));
+            left.push_back("x");
+            right.push_back("y");
+            assert(left.size() == 5 && left.back() == "x" && right.front() == left_items[1] && right.back() == "y");
+        }
+
+        DynamicCircularContainer<int> d(3, {1, 2, 3});
+        DynamicCircularContainer<int> e(10);
+        const int* buffer = d.array_one().first;
+        e.swap(d); // heap buffers trade places
+        assert(d.capacity() == 10 && d.empty() && e.capacity() == 3 && e.front() == 1);
+        assert(e.array_one().first == buffer);
+    }
+
+    {
+        // Test WindowedCircularContainer aggregates against a rescan of the window
+        WindowedCircularContainer<int, 5, window_sum, window_variance, window_min, window_max> w;
+        assert(w.empty() && w.sum() == 0 && w.mean() == 0.0);
+        bool threw = false;
+        try {
+            (void)w.min();
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+
+        unsigned seed = 3;
+        for (int step = 0; step < 500; ++step) {
+            seed = seed * 1103515245u + 12345u;
+            const int value = static_cast<int>((seed >> 16) % 41) - 20;
+            if (step % 11 == 10) {
+                w.pop_front();
+            } else {
+                w.push_back(value);
+            }
+            if (w.empty()) {
+                continue;
+            }
+            int sum = 0;
+            for (int x : w) {
+                sum += x;
+            }
+            const double mean = static_cast<double>(sum) / static_cast<double>(w.size());
+            double m2 = 0.0;
+            for (int x : w) {
+                m2 += (x - mean) * (x - mean);
+            }
+            assert(w.sum() == sum);
+            assert(std::abs(w.mean() - mean) < 1e-9);
+            assert(std::abs(w.variance() - m2 / static_cast<double>(w.size())) < 1e-9);
+            assert(w.min() == *std::min_element(w.begin(), w.end()));
+            assert(w.max() == *std::max_element(w.begin(), w.end()));
+        }
+        w.clear();
+        assert(w.empty() && w.sum() == 0 && w.variance() == 0.0);
+        w.push_back(7);
+        assert(w.min() == 7 && w.max() == 7 && w.mean() == 7.0 && w.front() == 7);
+
+        // Removing nearly equal values must not leave a negative variance
+        WindowedCircularContainer<double, 3, window_variance> flat;
+        seed = 1;
+        for (int step = 0; step < 1000; ++step) {
+            seed = seed * 1103515245u + 12345u;
+            flat.push_back(1.0 + ((seed >> 16) % 3) * 1e-7);
+            assert(flat.variance() >= 0.0 && !std::isnan(std::sqrt(flat.variance())));
+        }
+
+        WindowedCircularContainer<double, 3, window_max> peaks;
+        static_assert(sizeof(peaks) > 0);
+        peaks.push_back(1.5);
+        peaks.push_back(0.5);
+        peaks.push_back(0.25);
+        assert(peaks.max() == 1.5);
+        peaks.push_back(0.75); // 1.5 leaves the window
+        assert(peaks.max() == 0.75 && peaks.size() == 3);
+    }
+
+    {
+        // Test constant evaluation (C++20): construction, push_back, pop_front,
+        // iteration, initializer lists and the ring operations at compile time
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+        static_assert([] {
+            CircularContainer<int, 4> c;
+            for (int i = 1; i <= 6; ++i) {
+                c.push_back(i); // wraps: 3 4 5 6
+            }
+            c.pop_front();
+            int sum = 0;
+            for (int x : c) {
+                sum += x;
+            }
+            int reversed = 0;
+            for (auto it = c.rbegin(); it != c.rend(); ++it) {
+                reversed = reversed * 10 + *it;
+            }
+            return sum == 15 && reversed == 654 && c.front() == 4 && c.end() - c.begin() == 3;
+        }());
+
+        static_assert([] {
+            CircularContainer<int, 5> c{1, 2, 3};
+            c.push_front(0);
+            c.insert(c.begin() + 2, 9); // 0 1 9 2 3
+            c.erase(c.begin());
+            c.push_back(7); // 1 9 2 3 7
+            c.push_back(8); // 9 2 3 7 8
+            return c.full() && c[0] == 9 && c.back() == 8 && *std::find(c.begin(), c.end(), 3) == 3;
+        }());
+
+        // Elements with non-trivial lifetimes are constructed and destroyed too.
+        static_assert([] {
+            CircularContainer<std::string, 3> c{std::string("a"), std::string("bb")};
+            c.push_back(std::string(40, 'x')); // heap-allocated at compile time
+            c.push_back(std::string("ccc"));
+            auto copy = c;
+            copy.pop_front();
+            return c.front() == "bb" && copy.size() == 2 && copy.back() == "ccc";
+        }());
+
+        // A ring computed at compile time and stored as a constant.
+        constexpr auto squares = [] {
+            CircularContainer<int, 6> c;
+            for (int i = 0; i < 10; ++i) {
+                c.push_back(i * i);
+            }
+            c.pop_front();
+            return c;
+        }();
+        static_assert(squares.size() == 5 && squares.front() == 25 && squares[4] == 81);
+        assert(std::accumulate(squares.begin(), squares.end(), 0) == 25 + 36 + 49 + 64 + 81);
+
+        constexpr CircularContainer deduced{1.5, 2.5};
+        static_assert(deduced.capacity() == 2 && deduced.back() == 2.5);
+#endif
+#if defined(__cpp_constinit) && defined(__cpp_lib_constexpr_dynamic_alloc)
+        static_assert(std::is_trivially_destructible_v<CircularContainer<int, 16>>);
+        static_assert(!std::is_trivially_destructible_v<CircularContainer<std::string, 16>>);
+        assert(static_ring.empty());
+        static_ring.push_back(3);
+        assert(static_ring.front() == 3);
+#endif
+    }
+
+    {
+        // Test vfc::simd algorithms against plain loops, at every level the CPU has
+        using vfc::simd::simd_level;
+        auto check = [](auto& ring, auto value, auto threshold, simd_level level) {
+            using T = typename std::decay_t<decltype(ring)>::value_type;
+            std::vector<T> items(ring.begin(), ring.end());
+            std::vector<T> weights(items.size());
+            for (std::size_t i = 0; i < weights.size(); ++i) {
+                weights[i] = static_cast<T>(i % 3);
+            }
+            T total = T(), product = T();
+            for (std::size_t i = 0; i < items.size(); ++i) {
+                total += items[i];
+                product += items[i] * weights[i];
+            }
+            assert(vfc::simd::sum(ring, level) == total);
+            assert(vfc::simd::dot(ring, weights.data(), level) == product);
+            const auto [lo, hi] = vfc::simd::min_max(ring, level);
+            assert(lo == *std::min_element(items.begin(), items.end()));
+            assert(hi == *std::max_element(items.begin(), items.end()));
+            assert(vfc::simd::count(ring, value, level) ==
+                   static_cast<std::size_t>(std::count(items.begin(), items.end(), value)));
+            assert(vfc::simd::count_above(ring, threshold, level) ==
+                   static_cast<std::size_t>(std::count_if(items.begin(), items.end(), [&](T x) { return x > threshold; })));
+            assert(vfc::simd::find(ring, value, level) == std::find(ring.cbegin(), ring.cend(), value));
+            assert(vfc::simd::find_above(ring, threshold, level) ==
+                   std::find_if(ring.cbegin(), ring.cend(), [&](T x) { return x > threshold; }));
+        };
+
+        for (auto level : {simd_level::scalar, simd_level::sse4_1, simd_level::avx2}) {
+            // Small integral values keep the floating-point sums exact.
+            CircularContainer<float, 100> floats;
+            CircularContainer<double, 37> doubles;
+            CircularContainer<std::int32_t, 64> ints;
+            CircularContainer<short, 20> shorts; // no vector kernels: scalar path
+            for (int i = 0; i < 150; ++i) { // wrapped, so both runs are used
+                floats.push_back(static_cast<float>((i * 7) % 23));
+                doubles.push_back(static_cast<double>((i * 5) % 19) - 9.0);
+                ints.push_back((i * 11) % 29 - 14);
+                shorts.push_back(static_cast<short>(i % 9));
+            }
+            assert(!floats.is_linearized());
+            check(floats, 5.0f, 20.0f, level);
+            check(floats, 100.0f, 21.0f, level); // no match: end()
+            check(doubles, 0.0, 8.0, level);
+            check(ints, -3, 13, level);
+            check(ints, 1000, 1000, level);
+            check(shorts, static_cast<short>(4), static_cast<short>(7), level);
+
+            floats.clear();
+            assert(vfc::simd::sum(floats, level) == 0.0f);
+            assert(vfc::simd::find(floats, 1.0f, level) == floats.cend());
+            bool thrown = false;
+            try {
+                (void)vfc::simd::min_max(floats, level);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            assert(thrown);
+        }
+
+        DynamicCircularContainer<std::int32_t> dynamic(10, {4, 9, -2, 7});
+        assert(vfc::simd::sum(dynamic) == 18 && vfc::simd::min_max(dynamic) == std::make_pair(-2, 9));
+        assert(*vfc::simd::find_above(dynamic, 5) == 9);
+    }
+
+    {
+        // Test DynamicCircularContainer: runtime capacity, allocators, resizing
+        DynamicCircularContainer<int> d(5);
+        assert(d.empty() && d.capacity() == 5);
+        for (int i = 1; i <= 8; ++i) {
+            d.push_back(i);
+        }
+        assert(d.full() && d.front() == 4 && d.back() == 8);
+        assert(std::equal(d.begin(), d.end(), std::vector<int>{4, 5, 6, 7, 8}.begin()));
+        assert(d.rbegin()[1] == 7 && d.end() - d.begin() == 5);
+        assert(!d.is_linearized());
+
+        d.reserve(3); // never shrinks
+        assert(d.capacity() == 5);
+        d.reserve(7);
+        assert(d.capacity() == 7 && d.is_linearized() && d.size() == 5);
+        assert(d.array_one().first[0] == 4 && d.back() == 8);
+        d.push_back(9);
+        d.push_back(10);
+        d.push_back(11);
+        assert(d.front() == 5 && d.back() == 11);
+        d.resize_capacity(3); // keeps the newest elements
+        assert(d.capacity() == 3 && d.size() == 3 && d.front() == 9 && d.back() == 11);
+
+        DynamicCircularContainer<int> copy(d);
+        assert(copy.capacity() == 3 && std::equal(copy.begin(), copy.end(), d.begin()));
+        DynamicCircularContainer<int> moved(std::move(copy));
+        assert(moved.size() == 3 && copy.capacity() == 0 && copy.empty());
+        DynamicCircularContainer<int> other(10, {1, 2});
+        other = moved;
+        assert(other.capacity() == 3 && other.front() == 9);
+        copy = std::move(other);
+        assert(copy.size() == 3 && copy.back() == 11);
+
+        // A moved-from container behaves as one of capacity 0 until it gets room
+        // (the strings are long enough to live on the heap)
+        const std::string dropped(40, 'd');
+        DynamicCircularContainer<std::string, std::allocator<std::string>, overwrite_oldest, count_stats> source(2);
+        source.push_back(dropped);
+        DynamicCircularContainer<std::string, std::allocator<std::string>, overwrite_oldest, count_stats> target(
+            std::move(source));
+        source.reset_stats();
+        source.push_back(dropped);
+        source.push_back(std::string(dropped));
+        source.push_front(dropped);
+        source.insert(source.begin(), dropped);
+        std::vector<std::string> more{dropped, dropped};
+        source.push_back(more.begin(), more.end());
+        assert(source.empty() && source.capacity() == 0 && source.begin() == source.end());
+        assert(source.stats().pushes == 5 && source.stats().overwrites == 5);
+        bool threw = false;
+        try {
+            source.emplace_back(dropped);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw && source.empty());
+        source.reserve(2);
+        source.push_back(dropped);
+        assert(source.size() == 1 && source.front() == dropped && target.front() == dropped);
+        std::vector<std::string> evicted;
+        DynamicCircularContainer<std::string, std::allocator<std::string>, evict_to<std::function<void(std::string&&)>>>
+            none(0, evict_to<std::function<void(std::string&&)>>{[&](std::string&& s) { evicted.push_back(std::move(s)); }});
+        none.push_back(dropped);
+        assert(none.empty() && evicted.size() == 1 && evicted[0] == dropped);
+        DynamicCircularContainer<int, std::allocator<int>, reject_when_full> rejecting(1, {1});
+        DynamicCircularContainer<int, std::allocator<int>, reject_when_full> taker(std::move(rejecting));
+        assert(!rejecting.push_back(2) && rejecting.empty());
+        rejecting = taker;
+        assert(rejecting.size() == 1 && rejecting.front() == 1);
+
+        {
+            DynamicCircularContainer<Tracked> t(3);
+            for (int i = 0; i < 5; ++i) {
+                t.emplace_back(i);
+            }
+            assert(Tracked::live == 3);
+            t.resize_capacity(2);
+            assert(Tracked::live == 2 && t.front().value == 3);
+            t.insert(t.begin(), Tracked(9));
+            assert(Tracked::live == 2 && t.front().value == 9 && t.back().value == 3);
+        }
+        assert(Tracked::live == 0);
+
+        // Only allocators that can always hand their buffer over make moves noexcept.
+        using PmrRing = DynamicCircularContainer<int, std::pmr::polymorphic_allocator<int>>;
+        static_assert(std::is_nothrow_move_assignable_v<DynamicCircularContainer<int>>);
+        static_assert(std::is_nothrow_swappable_v<DynamicCircularContainer<int>>);
+        static_assert(std::is_nothrow_move_constructible_v<PmrRing>);
+        static_assert(!std::is_nothrow_move_assignable_v<PmrRing>);
+        static_assert(!std::is_nothrow_swappable_v<PmrRing>);
+        static_assert(std::is_nothrow_move_assignable_v<CircularContainer<int, 4>>);
+
+        // Elements and buffer both come from the container's memory resource.
+        std::pmr::monotonic_buffer_resource arena;
+        DynamicCircularContainer<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>> strings(2, &arena);
+        strings.emplace_back("a string long enough to need the heap");
+        strings.push_back(std::pmr::string("another string long enough to allocate"));
+        assert(strings.get_allocator().resource() == &arena);
+        assert(strings.front().get_allocator().resource() == &arena);
+        std::vector<std::pmr::string> batch{"x", "a third string long enough to allocate"};
+        strings.push_back(batch.begin(), batch.end());
+        assert(strings.back().get_allocator().resource() == &arena && strings.front() == "x");
+        strings.resize_capacity(4);
+        assert(strings.back().get_allocator().resource() == &arena && strings.size() == 2);
+    }
+
+#ifdef __linux__
+    {
+        // Test MirroredCircularContainer: every window is contiguous across the wrap
+        MirroredCircularContainer<char> ring(100);
+        const std::size_t cap = ring.capacity();
+        assert(cap >= 100 && ring.empty());
+        std::vector<char> chunk(cap - 3, 'a');
+        ring.push_back(chunk.data(), chunk.size());
+        ring.pop_front(cap - 5); // head is now 2 elements before the end of the buffer
+        const char record[] = "0123456789";
+        auto window = ring.contiguous_write(10);
+        assert(window.second == 10);
+        std::memcpy(window.first, record, 10);
+        ring.commit_write(10);
+        assert(ring.size() == 12 && ring.front() == 'a' && ring.back() == '9');
+        auto read = ring.contiguous_read(100);
+        assert(read.second == 12 && std::memcmp(read.first + 2, record, 10) == 0);
+        assert(std::string(ring.begin() + 2, ring.end()) == "0123456789");
+        ring.pop_front(2);
+        assert(ring[0] == '0' && ring.at(9) == '9');
+
+        for (std::size_t i = 0; i < cap + 7; ++i) {
+            ring.push_back(static_cast<char>('A' + i % 26)); // overwrites the oldest once full
+        }
+        assert(ring.full() && ring.contiguous_write(1).second == 0);
+        assert(ring.back() == static_cast<char>('A' + (cap + 6) % 26));
+        bool threw = false;
+        try {
+            ring.commit_write(1);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+
+        MirroredCircularContainer<char> moved(std::move(ring));
+        assert(moved.full() && ring.capacity() == 0);
+        ring.push_back('x'); // a moved-from ring drops what it is given
+        ring.push_back("xyz", 3);
+        assert(ring.empty() && ring.begin() == ring.end() && ring.contiguous_write(8).second == 0);
+        ring.commit_write(0);
+        ring = std::move(moved);
+        assert(ring.full() && ring.capacity() >= 100);
+        ring.push_back('y');
+        assert(ring.back() == 'y');
+    }
+
+    {
+        // Test PersistentCircularContainer: the ring survives closing and reopening its file
+        struct Event {
+            std::uint64_t id;
+            double value;
+        };
+        const std::string path = "/tmp/vfc_persistent_test_" + std::to_string(::getpid()) + ".ring";
+        std::remove(path.c_str());
+        {
+            PersistentCircularContainer<Event> ring(path, 5, 3);
+            assert(ring.empty() && ring.capacity() == 5 && ring.version() == 3);
+            for (std::uint64_t i = 0; i < 8; ++i) {
+                ring.push_back(Event{i, i * 0.5}); // overwrites 0, 1 and 2
+            }
+            assert(ring.full() && ring.front().id == 3 && ring.back().id == 7);
+            ring.pop_front();
+            ring.set_sync_interval(2);
+            ring.push_back(Event{8, 4.0});
+            ring.sync();
+        }
+        {
+            PersistentCircularContainer<Event> ring(path, 0, 3); // 0 takes the stored capacity
+            assert(ring.capacity() == 5 && ring.size() == 5);
+            std::uint64_t expected = 4;
+            for (const Event& e : ring) {
+                assert(e.id == expected && e.value == expected * 0.5);
+                ++expected;
+            }
+            assert(ring[0].id == 4 && ring.at(4).id == 8 && ring.rbegin()->id == 8);
+            assert(std::find_if(ring.begin(), ring.end(), [](const Event& e) { return e.id == 6; }) - ring.begin() == 2);
+            ring.pop_back();
+            ring.push_back(Event{9, 4.5});
+            ring.clear();
+            ring.push_back(Event{10, 5.0});
+        }
+        {
+            PersistentCircularContainer<Event> ring(path, 5, 3);
+            assert(ring.size() == 1 && ring.front().id == 10);
+            PersistentCircularContainer<Event> moved(std::move(ring));
+            assert(moved.back().id == 10);
+            moved.pop_back();
+            moved.pop_back(); // no-op when empty, as for CircularContainer
+            moved.pop_front();
+            assert(moved.empty());
+            moved.push_back(Event{11, 5.5});
+            moved.push_back(Event{12, 6.0});
+        }
+        {
+            // Slots are found through the header's offset, not this host's page
+            // size: rewrite the file as a 64 KiB-page host would have laid it out
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t far = std::size_t{1} << 16;
+            std::vector<char> bytes(far + 5 * sizeof(Event));
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            assert(file && std::fread(bytes.data(), 1, page + 5 * sizeof(Event), file) == page + 5 * sizeof(Event));
+            std::fclose(file);
+            std::memmove(bytes.data() + far, bytes.data() + page, 5 * sizeof(Event));
+            detail::persistent_ring_header header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            assert(header.data_offset == page);
+            header.data_offset = far;
+            std::memcpy(bytes.data(), &header, sizeof(header));
+            file = std::fopen(path.c_str(), "wb");
+            assert(file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+            std::fclose(file);
+            PersistentCircularContainer<Event> ring(path, 5, 3);
+            assert(ring.size() == 2 && ring.front().id == 11 && ring.back().id == 12);
+        }
+        const auto rejects = [&](auto open) {
+            try {
+                open();
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        };
+        assert(rejects([&] { PersistentCircularContainer<Event> ring(path, 6, 3); }));
+        assert(rejects([&] { PersistentCircularContainer<Event> ring(path, 5, 4); }));
+        assert(rejects([&] { PersistentCircularContainer<std::uint64_t> ring(path, 0, 3); }));
+        std::remove(path.c_str());
+    }
+#endif
+
+    {
+        // Test SpscCircularContainer: pushes fail instead of overwriting when full
+        SpscCircularContainer<int, 3> q;
+        assert(q.empty() && q.capacity() == 3);
+        assert(q.try_push(1) && q.try_push(2) && q.try_push(3));
+        assert(!q.try_push(4));
+        assert(q.size() == 3);
+        int out = 0;
+        assert(q.try_pop(out) && out == 1);
+        assert(q.try_push(4));
+        assert(q.try_pop(out) && out == 2);
+        assert(q.try_pop(out) && out == 3);
+        assert(q.try_pop(out) && out == 4);
+        assert(!q.try_pop(out) && q.empty());
+
+        // Slots are raw storage: no default constructor needed, and only the
+        // queued elements are alive
+        {
+            SpscCircularContainer<Tracked, 4, atomic_stats> tracked;
+            assert(Tracked::live == 0);
+            assert(tracked.try_emplace(1) && tracked.try_push(Tracked(2)) && tracked.try_emplace(3));
+            assert(Tracked::live == 3);
+            Tracked popped(0);
+            assert(tracked.try_pop(popped) && popped.value == 1 && Tracked::live == 3);
+            const container_stats stats = tracked.stats();
+            assert(stats.pushes == 3 && stats.pops == 1 && stats.peak_size == 3);
+        }
+        assert(Tracked::live == 0);
+    }
+
+    {
+        // Test SpscCircularContainer across a producer and a consumer thread
+        constexpr int COUNT = 100000;
+        SpscCircularContainer<int, 64> q;
+        std::thread producer([&q] {
+            for (int i = 0; i < COUNT; ++i) {
+                while (!q.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        int expected = 0;
+        while (expected < COUNT) {
+            int out;
+            if (q.try_pop(out)) {
+                assert(out == expected);
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        assert(q.empty());
+    }
+
+    {
+        // Test MpmcCircularContainer: try_push fails when full, push_back overwrites oldest
+        MpmcCircularContainer<int, 3> q;
+        assert(q.try_push(1) && q.try_push(2) && q.try_push(3));
+        assert(!q.try_push(4));
+        q.push_back(4);
+        assert(q.size() == 3);
+        int out = 0;
+        assert(q.try_pop(out) && out == 2);
+        assert(q.try_pop(out) && out == 3);
+        assert(q.try_pop(out) && out == 4);
+        assert(!q.try_pop(out) && q.empty());
+    }
+
+    {
+        // Test MpmcCircularContainer with several producers and consumers
+        constexpr int THREADS = 4;
+        constexpr int PER_THREAD = 20000;
+        MpmcCircularContainer<long, 64> q;
+        std::atomic<long> sum{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&q] {
+                for (long i = 1; i <= PER_THREAD; ++i) {
+                    while (!q.try_push(i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            threads.emplace_back([&q, &sum] {
+                long out;
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    while (!q.try_pop(out)) {
+                        std::this_thread::yield();
+                    }
+                    sum += out;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(sum == THREADS * (long(PER_THREAD) * (PER_THREAD + 1) / 2));
+        assert(q.empty());
+    }
+
+    {
+        // Test BlockingCircularContainer: non-blocking paths, timeout and close()
+        BlockingCircularContainer<int, 2> q;
+        assert(q.try_push(1) && q.try_push(2) && !q.try_push(3));
+        int out = 0;
+        assert(q.pop_wait(out) && out == 1);
+        assert(q.pop_wait_for(out, std::chrono::milliseconds(1)) && out == 2);
+        auto start = std::chrono::steady_clock::now();
+        assert(!q.pop_wait_for(out, std::chrono::milliseconds(20)));
+        assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+        assert(q.push_wait(3));
+        q.close();
+        assert(q.closed() && !q.push_wait(4) && !q.try_push(4));
+        assert(q.pop_wait(out) && out == 3); // drained after close
+        assert(!q.pop_wait(out) && !q.pop_wait_for(out, std::chrono::seconds(10)));
+    }
+
+    {
+        // Test BlockingCircularContainer: timeouts beyond steady_clock's range wait forever
+        BlockingCircularContainer<int, 2> q;
+        int out = 0;
+        assert(!q.pop_wait_for(out, std::chrono::nanoseconds::min()));
+        assert(!q.pop_wait_for(out, std::chrono::hours(-1)));
+        assert(q.try_push(1) && q.pop_wait_for(out, std::chrono::hours::max()) && out == 1);
+        std::thread producer([&q] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            q.try_push(2);
+        });
+        assert(q.pop_wait_for(out, std::chrono::steady_clock::duration::max()) && out == 2);
+        producer.join();
+        std::thread closer([&q] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            q.close();
+        });
+        assert(!q.pop_wait_for(out, std::chrono::hours::max()));
+        closer.join();
+    }
+
+    {
+        // Test BlockingCircularContainer: sleepers are woken by the other side and by close()
+        constexpr int THREADS = 3;
+        constexpr int PER_THREAD = 20000;
+        BlockingCircularContainer<long, 4> q;
+        std::atomic<long> sum{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&q] {
+                for (long i = 1; i <= PER_THREAD; ++i) {
+                    bool pushed = q.push_wait(i);
+                    assert(pushed);
+                    (void)pushed;
+                }
+            });
+            threads.emplace_back([&q, &sum] {
+                long out;
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    bool popped = q.pop_wait(out);
+                    assert(popped);
+                    (void)popped;
+                    sum += out;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(sum == THREADS * (long(PER_THREAD) * (PER_THREAD + 1) / 2));
+        assert(q.empty());
+
+        std::thread sleeper([&q] {
+            long out;
+            bool popped = q.pop_wait(out);
+            assert(!popped);
+            (void)popped;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        q.close();
+        sleeper.join();
+    }
+
+    {
+        // Test SeqlockCircularContainer: latest(k) returns the k newest elements
+        SeqlockCircularContainer<int, 5> ring;
+        int out[8] = {};
+        assert(ring.empty() && ring.latest(3, out) == 0 && !ring.back(out[0]));
+        ring.push_back(1);
+        ring.push_back(2);
+        assert(ring.latest(8, out) == 2 && out[0] == 1 && out[1] == 2);
+        for (int i = 3; i <= 12; ++i) {
+            ring.push_back(i); // overwrites the oldest once full
+        }
+        assert(ring.size() == 5 && ring.total_pushed() == 12);
+        assert(ring.latest(8, out) == 5 && out[0] == 8 && out[4] == 12);
+        assert(ring.latest(3, out) == 3 && out[0] == 10 && out[2] == 12);
+        int newest = 0;
+        assert(ring.back(newest) && newest == 12);
+    }
+
+    {
+        // Test SeqlockCircularContainer: readers never see a torn or stale window
+        struct Sample {
+            long sequence;
+            long check; // always -sequence
+        };
+        constexpr long COUNT = 200000;
+        SeqlockCircularContainer<Sample, 64> ring;
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&ring, &done] {
+                Sample window[8];
+                long last_newest = -1;
+                while (!done.load()) {
+                    const std::size_t n = ring.latest(8, window);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        assert(window[i].check == -window[i].sequence);
+                        assert(i == 0 || window[i].sequence == window[i - 1].sequence + 1);
+                    }
+                    if (n != 0) {
+                        assert(window[n - 1].sequence >= last_newest);
+                        last_newest = window[n - 1].sequence;
+                    }
+                }
+            });
+        }
+        for (long i = 0; i < COUNT; ++i) {
+            ring.push_back(Sample{i, -i});
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        Sample last{};
+        assert(ring.back(last) && last.sequence == COUNT - 1);
+    }
+
     std::cout << "All tests passed!\n";
     return 0;
 }